@@ -0,0 +1,225 @@
+/*
+  binary_stream.c - binary motion streaming protocol
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_BINARY_STREAMING
+
+// Binary stream decoder flags.
+#define BINARY_FLAG_ACTIVE  bit(0) // Binary streaming mode enabled.
+#define BINARY_FLAG_ESCAPE  bit(1) // Last byte was BINARY_FRAME_ESCAPE.
+#define BINARY_FLAG_ERROR   bit(2) // Frame is malformed. Remaining bytes are discarded until frame end.
+
+typedef struct {
+  uint8_t flags;
+  uint8_t count;       // Number of decoded frame bytes.
+  uint8_t group;       // Position in the 8-byte wire group. Zero expects the group's MSB byte.
+  uint8_t msb;         // Most significant bits of the data bytes in the current wire group.
+  uint8_t ack_count;   // Number of executed frames not yet acknowledged.
+  uint8_t frame[BINARY_FRAME_SIZE];
+} binary_stream_t;
+static binary_stream_t bin;
+
+
+void binary_stream_init()
+{
+  memset(&bin, 0, sizeof(binary_stream_t));
+}
+
+
+void binary_stream_start()
+{
+  binary_stream_init();
+  bin.flags = BINARY_FLAG_ACTIVE;
+}
+
+
+uint8_t binary_stream_is_active() { return(bin.flags & BINARY_FLAG_ACTIVE); }
+
+
+uint8_t binary_stream_read(uint8_t data)
+{
+  if (data == BINARY_FRAME_END) {
+    if (bin.flags & BINARY_FLAG_ESCAPE) { bin.flags |= BINARY_FLAG_ERROR; } // Dangling escape.
+    return(true);
+  }
+  if (bin.flags & BINARY_FLAG_ESCAPE) {
+    bin.flags &= ~BINARY_FLAG_ESCAPE;
+    data ^= BINARY_FRAME_ESCAPE_XOR;
+  } else if (data == BINARY_FRAME_ESCAPE) {
+    bin.flags |= BINARY_FLAG_ESCAPE;
+    return(false);
+  }
+
+  // Frame bytes are sent seven bits at a time, since the RX ISR intercepts extended ASCII. Each group
+  // of up to seven frame bytes starts with a byte holding their most significant bits, lowest first.
+  if (bin.group == 0) {
+    bin.msb = data;
+  } else if (bin.count < BINARY_FRAME_SIZE) {
+    bin.frame[bin.count++] = (data & 0x7F) | ((bin.msb << (8-bin.group)) & 0x80);
+  } else {
+    bin.flags |= BINARY_FLAG_ERROR; // Frame too long.
+  }
+  if (++bin.group == 8) { bin.group = 0; }
+  return(false);
+}
+
+
+// Checks and executes the decoded frame. Mirrors the feed rate, spindle speed, and motion steps of
+// gc_execute_line() for a G0/G1 block with absolute targets, and updates the g-code parser state, so
+// that ASCII g-code continues seamlessly after binary streaming ends.
+static uint8_t binary_stream_execute()
+{
+  if (bin.flags & BINARY_FLAG_ERROR) { return(STATUS_BINARY_FRAME_ERROR); }
+  if (bin.count == 0) { return(STATUS_OK); } // Empty frame. For syncing purposes.
+
+  // Check frame length against the header and the CRC. The CRC is sent most significant byte first,
+  // so the CRC over the whole frame is zero when it is intact.
+  uint8_t header = bin.frame[0];
+  uint8_t axis_words = header & BINARY_HEADER_AXIS_MASK;
+  uint8_t length = 3; // Header and CRC
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_istrue(axis_words,bit(idx))) { length += 4; }
+  }
+  if (header & BINARY_HEADER_FEED_RATE) { length += 2; }
+  if (header & BINARY_HEADER_SPINDLE_SPEED) { length += 2; }
+  if ((bin.count != length) || (header & 0x80)) { return(STATUS_BINARY_FRAME_ERROR); }
+  uint16_t crc = 0;
+  for (idx=0; idx<length; idx++) { crc = crc16_update(crc, bin.frame[idx]); }
+  if (crc) { return(STATUS_BINARY_FRAME_ERROR); }
+
+  if (header & BINARY_HEADER_EXIT) {
+    if (length != 3) { return(STATUS_BINARY_FRAME_ERROR); }
+    bin.flags &= ~BINARY_FLAG_ACTIVE;
+    return(STATUS_OK);
+  }
+  if (sys.state & (STATE_ALARM | STATE_JOG)) { return(STATUS_SYSTEM_GC_LOCK); }
+
+  // Unpack little-endian values. Axis targets are in thousandths of a mm in work coordinates.
+  uint8_t *ptr = &bin.frame[1];
+  float target[N_AXIS];
+  memcpy(target, gc_state.position, sizeof(target));
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_istrue(axis_words,bit(idx))) {
+      int32_t value;
+      memcpy(&value, ptr, sizeof(int32_t));
+      ptr += sizeof(int32_t);
+      // NOTE: Scaled as read_float() scales a value with three decimal places, so that binary and
+      // ASCII targets round to the same steps.
+      target[idx] = value;
+      target[idx] *= 0.01;
+      target[idx] *= 0.1;
+      target[idx] += gc_state.coord_system[idx] + gc_state.coord_offset[idx];
+      if (idx == TOOL_LENGTH_OFFSET_AXIS) { target[idx] += gc_state.tool_length_offset; }
+    }
+  }
+  uint16_t value;
+  float feed_rate = gc_state.feed_rate;
+  if (header & BINARY_HEADER_FEED_RATE) {
+    memcpy(&value, ptr, sizeof(uint16_t));
+    ptr += sizeof(uint16_t);
+    feed_rate = value;
+  }
+  float spindle_speed = gc_state.spindle_speed;
+  if (header & BINARY_HEADER_SPINDLE_SPEED) {
+    memcpy(&value, ptr, sizeof(uint16_t));
+    spindle_speed = value;
+  }
+  uint8_t rapid = header & BINARY_HEADER_RAPID_MOTION;
+  if (axis_words && !rapid && (feed_rate == 0.0)) { return(STATUS_GCODE_UNDEFINED_FEED_RATE); }
+
+  // Set feed rate and spindle speed, as g-code steps 3 and 4 would.
+  uint8_t gc_parser_flags = GC_PARSER_NONE;
+  if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
+    if (rapid) { gc_parser_flags |= GC_PARSER_LASER_DISABLE; }
+    if (axis_words) { gc_parser_flags |= GC_PARSER_LASER_ISMOTION; }
+  }
+  gc_state.feed_rate = feed_rate;
+  if (gc_state.spindle_speed != spindle_speed) {
+    if (gc_state.modal.spindle != SPINDLE_DISABLE) {
+      #ifdef VARIABLE_SPINDLE
+        if (bit_isfalse(gc_parser_flags,GC_PARSER_LASER_ISMOTION)) {
+          if (bit_istrue(gc_parser_flags,GC_PARSER_LASER_DISABLE)) {
+            spindle_sync(gc_state.modal.spindle, 0.0);
+          } else { spindle_sync(gc_state.modal.spindle, spindle_speed); }
+        }
+      #else
+        spindle_sync(gc_state.modal.spindle, 0.0);
+      #endif
+    }
+    gc_state.spindle_speed = spindle_speed;
+  }
+  if (!axis_words) { return(STATUS_OK); }
+
+  plan_line_data_t plan_data;
+  plan_line_data_t *pl_data = &plan_data;
+  memset(pl_data,0,sizeof(plan_line_data_t));
+  pl_data->feed_rate = gc_state.feed_rate;
+  if (bit_isfalse(gc_parser_flags,GC_PARSER_LASER_DISABLE)) { pl_data->spindle_speed = gc_state.spindle_speed; }
+  pl_data->condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+  #ifdef ENABLE_PATH_BLENDING
+    if (gc_state.modal.control == CONTROL_MODE_CONTINUOUS) {
+      if (gc_state.blend_tolerance > 0.0) { pl_data->blend_tolerance = gc_state.blend_tolerance; }
+      else { pl_data->blend_tolerance = settings.junction_deviation; }
+    }
+  #endif
+  if (rapid) {
+    pl_data->condition |= PL_COND_FLAG_RAPID_MOTION;
+    gc_state.modal.motion = MOTION_MODE_SEEK;
+  } else {
+    gc_state.modal.motion = MOTION_MODE_LINEAR;
+  }
+
+  // Acknowledge frames already in the planner before blocking on a full buffer, so the host can keep
+  // the serial read buffer filled.
+  if (plan_check_full_buffer()) { binary_stream_flush_ack(); }
+  mc_line(target, pl_data);
+  memcpy(gc_state.position, target, sizeof(target));
+  return(STATUS_OK);
+}
+
+
+void binary_stream_execute_frame()
+{
+  uint8_t status_code = binary_stream_execute();
+  bin.flags &= BINARY_FLAG_ACTIVE; // Reset decoder for next frame.
+  bin.count = 0;
+  bin.group = 0;
+
+  // Every frame, including empty ones, is acknowledged exactly once. Errors are reported in order,
+  // after any pending acknowledgements.
+  if (status_code == STATUS_OK) {
+    bin.ack_count++;
+    if ((bin.ack_count >= BINARY_ACK_BATCH) || !(bin.flags & BINARY_FLAG_ACTIVE)) { binary_stream_flush_ack(); }
+  } else {
+    binary_stream_flush_ack();
+    report_status_message(status_code);
+  }
+}
+
+
+void binary_stream_flush_ack()
+{
+  if (bin.ack_count) {
+    report_binary_ack(bin.ack_count);
+    bin.ack_count = 0;
+  }
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*
+  binary_stream.h - binary motion streaming protocol
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef binary_stream_h
+#define binary_stream_h
+
+// Binary frame wire characters. A frame ends with BINARY_FRAME_END. Any frame byte that is a realtime
+// command character, BINARY_FRAME_END, or BINARY_FRAME_ESCAPE is sent as BINARY_FRAME_ESCAPE followed
+// by the byte XOR'd with BINARY_FRAME_ESCAPE_XOR.
+#define BINARY_FRAME_END 0x0A // '\n'
+#define BINARY_FRAME_ESCAPE 0x1B
+#define BINARY_FRAME_ESCAPE_XOR 0x40
+
+// Binary frame header bit flags. The header is the first byte of each decoded frame. Axis flags use
+// bits 0 to N_AXIS-1 and mark which axis targets follow the header.
+#define BINARY_HEADER_FEED_RATE     bit(3) // uint16 feed rate in mm/min follows the axis targets.
+#define BINARY_HEADER_SPINDLE_SPEED bit(4) // uint16 spindle speed follows the feed rate.
+#define BINARY_HEADER_RAPID_MOTION  bit(5) // Motion is a rapid, as with G0.
+#define BINARY_HEADER_EXIT          bit(6) // Return to ASCII g-code. Frame must not carry any values.
+#define BINARY_HEADER_AXIS_MASK     ((1<<N_AXIS)-1)
+
+// Decoded frame size limit. Header, int32 axis targets, uint16 feed and speed, and uint16 CRC.
+#define BINARY_FRAME_SIZE (1+4*N_AXIS+2+2+2)
+
+// Resets the binary stream state and returns to ASCII g-code. Called upon a system reset.
+void binary_stream_init();
+
+// Enters binary streaming mode. Called by the protocol loop when it receives CMD_BINARY_MODE.
+void binary_stream_start();
+
+// Returns true while in binary streaming mode.
+uint8_t binary_stream_is_active();
+
+// Decodes one received serial byte. Returns true when the byte ends a frame, which the protocol
+// loop then executes with binary_stream_execute_frame().
+uint8_t binary_stream_read(uint8_t data);
+
+// Checks and executes the last received frame, and reports its status, batching acknowledgements.
+void binary_stream_execute_frame();
+
+// Sends any pending frame acknowledgements. Called when the serial read buffer runs empty.
+void binary_stream_flush_ack();
+
+#endif
@@ -64,6 +64,7 @@
 #define CMD_SAFETY_DOOR 0x84
 #define CMD_JOG_CANCEL  0x85
 #define CMD_DEBUG_REPORT 0x86 // Only when DEBUG enabled, sends debug report in '{}' braces.
+#define CMD_BINARY_MODE 0x87 // Only when ENABLE_BINARY_STREAMING enabled. Passed in-band. See below.
 #define CMD_FEED_OVR_RESET 0x90         // Restores feed override value to 100%.
 #define CMD_FEED_OVR_COARSE_PLUS 0x91
 #define CMD_FEED_OVR_COARSE_MINUS 0x92
@@ -168,6 +169,18 @@
 // NOTE: The M8 flood coolant control pin on analog pin 3 will still be functional regardless.
 // #define ENABLE_M7 // Disabled by default. Uncomment to enable.
 
+// Enables the G64 continuous path control mode with an optional `G64 P<tolerance>` path blending
+// tolerance in the active units. In G64, the planner sizes each junction speed for the arc circle
+// tangent to both path segments, which deviates from the corner by no more than the tolerance and
+// stays within half the length of either segment. Dense CAM polylines then pass through their
+// vertices near the speed of the curve they trace, rather than slowing to the junction deviation
+// speed at every vertex. `G61` restores the default exact path mode. G64 without a P word uses
+// the last programmed tolerance. `G64 P0` falls back to the $11 junction deviation, the same
+// junction speeds as G61, and a negative P is rejected with error 4.
+// NOTE: Grbl still moves through every programmed vertex. The tolerance only sets the speed limit
+// of each junction, much like a per-program junction deviation setting.
+// #define ENABLE_PATH_BLENDING // Default disabled. Uncomment to enable.
+
 // This option causes the feed hold input to act as a safety door switch. A safety door, when triggered,
 // immediately forces a feed hold and then safely de-energizes the machine. Resuming is blocked until
 // the safety door is re-engaged. When it is, Grbl will re-energize the machine and then resume on the
@@ -287,6 +300,23 @@
 #define REPORT_WCO_REFRESH_BUSY_COUNT 30  // (2-255)
 #define REPORT_WCO_REFRESH_IDLE_COUNT 10  // (2-255) Must be less than or equal to the busy count
 
+// Enables automatic status reports. With the `$14` setting set to an interval in milliseconds, Grbl
+// sends status reports by itself at that interval, so a GUI doesn't need to poll with `?`. The interval
+// is timed by the watchdog timer interrupt, in ticks of about 16msec. Automatic reports omit the fields
+// that have not changed since the last report, and are skipped altogether when nothing has changed.
+// They are held back until the serial TX buffer has drained, so they never delay the responses to
+// streamed lines. A `?` still returns a complete report.
+// NOTE: Not compatible with ENABLE_SOFTWARE_DEBOUNCE, which also uses the watchdog timer.
+// #define ENABLE_AUTO_REPORT // Default disabled. Uncomment to enable.
+
+// Enables compact binary status reports. After a `$B=1` command, status reports are sent as fixed
+// size binary frames with the raw step positions, state, buffer states, rates, and overrides, and a
+// CRC, rather than as `<...>` text. A frame is several times shorter than a typical text report and
+// needs no float to text conversions, so a GUI can monitor the position at high rates without taking
+// serial bandwidth or CPU time away from streaming. `$B=0` or a reset returns to text reports. See
+// doc/markdown/interface.md for the frame format.
+// #define ENABLE_BINARY_STATUS_REPORT // Default disabled. Uncomment to enable.
+
 // The temporal resolution of the acceleration management subsystem. A higher number gives smoother
 // acceleration, particularly noticeable on machines that run at very high feedrates, but may negatively
 // impact performance. The correct value for this parameter is machine dependent, so it's advised to
@@ -294,7 +324,23 @@
 // NOTE: Changing this value also changes the execution time of a segment in the step segment buffer.
 // When increasing this value, this stores less overall time in the segment buffer and vice versa. Make
 // certain the step segment buffer is increased/decreased to account for these changes.
-#define ACCELERATION_TICKS_PER_SECOND 100
+#ifndef ACCELERATION_TICKS_PER_SECOND
+  #define ACCELERATION_TICKS_PER_SECOND 100
+#endif
+
+// Computes the step segments in scaled integer (fixed-point) arithmetic, instead of software floats.
+// Whole segments within an acceleration, cruise, or deceleration ramp are integrated with integer
+// adds in 1/256 step distance units, and their step counts and step rates with a single 32-bit
+// division. Only the few segments per block that contain a ramp change, the end of the block, or a
+// very slow motion fall back to the exact floating point solution. The steps are the same as the float
+// version, but each segment's step period may differ from it by one CPU cycle of round-off. So, the step
+// timing slowly drifts apart by up to one CPU cycle per step, or about 2ms over the six minute job of
+// 'make sim_equivalence', which compares both versions on the host, also at a doubled
+// ACCELERATION_TICKS_PER_SECOND. The lower CPU load per segment is meant to leave room for a higher
+// ACCELERATION_TICKS_PER_SECOND, but check the stepper on the AVR before raising it. Uses about 40 bytes
+// more RAM.
+// NOTE: Not compatible with JERK_LIMITED_PROFILES.
+// #define FIXED_POINT_SEGMENTS // Default disabled. Uncomment to enable.
 
 // Adaptive Multi-Axis Step Smoothing (AMASS) is an advanced feature that does what its name implies,
 // smoothing the stepping of multi-axis motions. This feature smooths motion particularly at low step
@@ -303,6 +349,20 @@
 // step smoothing. See stepper.c for more details on the AMASS system works.
 #define ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING  // Default enabled. Comment to disable.
 
+// Enables jerk-limited (S-curve) velocity profiles. Each acceleration and deceleration ramp eases in
+// and out of the acceleration limit at the jerk rate set by the per-axis jerk settings ($140-$142,
+// in mm/sec^3), rather than stepping straight to full acceleration. This removes the acceleration
+// step that excites gantry and frame resonances, so machines can typically run a much higher
+// acceleration setting. The planner still plans junction speeds with constant acceleration, which
+// the segment generator treats as speed limits. It looks ahead through the planner buffer and plans
+// S-curve ramps that may span any number of blocks, so strings of short blocks still reach full
+// speed. Feed holds decelerate along an S-curve ramp across as many blocks as necessary.
+// NOTE: Each ramp uses the lowest acceleration and jerk of the blocks it spans. Planner replans and
+// override changes that can no longer be met by the ramp in progress restart it from the current
+// speed. The look-ahead makes the segment computations considerably longer and adds ~150 bytes of
+// RAM, so very short, fast blocks may starve the segment buffer on an ATmega328p.
+// #define JERK_LIMITED_PROFILES // Default disabled. Uncomment to enable.
+
 // Sets the maximum step rate allowed to be written as a Grbl setting. This option enables an error
 // check in the settings module to prevent settings values that will exceed this limitation. The maximum
 // step rate is strictly limited by the CPU speed and will change if something other than an AVR running
@@ -406,6 +466,62 @@
 // much greater than this. The default setting should capture most, if not all, full arc error situations.
 #define ARC_ANGULAR_TRAVEL_EPSILON 5E-7 // Float (radians)
 
+// Merges consecutive collinear or nearly collinear line motions into the last planner block, before
+// it begins executing. CAM and raster programs often stream thousands of very short segments, each
+// of which would otherwise use up one of the few planner blocks and shorten the look-ahead distance.
+// A line merges only when it has the same feed rate, spindle speed, and run conditions as the last
+// block, turns less than the max angle from it, and no merged vertex would end up farther than the
+// tolerance from the resulting straight line. Inverse time motions are never merged.
+// NOTE: The merged path deviates from the programmed vertices by up to the tolerance. Keep it at or
+// below the $12 arc tolerance. Merging needs another block ahead of the last one in the buffer.
+// #define ENABLE_LINE_MERGING // Default disabled. Uncomment to enable.
+#define LINE_MERGE_TOLERANCE 0.002 // Float (mm)
+#define LINE_MERGE_MAX_ANGLE 0.2 // Float (radians)
+
+// Adds a small queue of parsed blocks between the g-code parser and the planner. When the planner buffer
+// is full, mc_line() stores the parsed target and planner data in the queue and returns, instead of
+// waiting, so the main loop reads and parses the following lines while the planner is full. Whenever a
+// planner block frees up, it is refilled right away from the queue, without waiting for the next line
+// to be parsed. This keeps the planner full with streams of very short segments. The parser only waits
+// once the queue is full too. Each queued block takes about 25 bytes of RAM, more with some options.
+// #define ENABLE_BLOCK_QUEUE // Default disabled. Uncomment to enable.
+#define BLOCK_QUEUE_SIZE 4 // (1-255) Number of parsed blocks held while the planner buffer is full.
+
+// Adds a fast path to the g-code parser for the most common streamed block, one that only continues
+// the active G0 or G1 motion mode with axis words and optional F, S, and N words, like `X10.5Y2S300`.
+// Such a block is executed straight from its words, skipping the parser block initialization and the
+// error-checks for commands and modes it can't contain, with exactly the same effect. Any other block,
+// or one with an error, is parsed by the full parser as usual. `make sim_gcode_bench` compares the
+// per-line parser time on the host with and without this option.
+// #define ENABLE_GCODE_FAST_PATH // Default disabled. Uncomment to enable.
+
+// Plans G2/G3 arcs as native arc blocks, instead of breaking them into many short line segments that
+// each use up a planner block. An arc is split only where it crosses a quadrant boundary of its plane,
+// so a full circle takes at most five blocks and soft limits still check the extremes of the arc.
+// Each arc block is velocity planned once, with its nominal rate capped by the centripetal acceleration
+// the plane axes can sustain at its radius. The stepper segment generator then interpolates the arc
+// into chords on the fly, keeping them within the $12 arc tolerance at any speed.
+// NOTE: Adds 14 bytes of RAM per planner block. On a 328p, combining this with other options may
+// require a smaller BLOCK_BUFFER_SIZE. Not compatible with COREXY.
+// #define ENABLE_NATIVE_ARCS // Default disabled. Uncomment to enable.
+
+// Enables the `$R=` laser raster scanline command in laser mode. Each command moves from the current
+// position by the number of pixels times the pixel travel vector, as a single G1 planner block at the
+// modal feed rate. The stepper ISR traces the pixel boundaries along with the steps and sets the
+// laser PWM at each one, so every pixel gets its own power, however short it is. Pixel PWM values are
+// queued in a ring buffer of RASTER_BUFFER_SIZE bytes. See doc/markdown/laser_mode.md.
+// NOTE: Requires VARIABLE_SPINDLE. Each pixel must span at least one step of the dominant axis.
+// #define ENABLE_RASTER_MODE // Default disabled. Uncomment to enable.
+#define RASTER_BUFFER_SIZE 128 // (LINE_BUFFER_SIZE-255) Pixels
+
+// Adds a lead-in and a lead-out motion, with the laser off, to each `$R=` raster scanline. They are
+// as long as the distance to reach the feed rate at the axis acceleration, so the pixels are burned
+// at a constant speed. A scanline sent from the end of the last lead-out, in the same direction,
+// continues the last scanline, and its lead-out is dropped if it has not started executing. The
+// g-code parser position is left at the end of the lead-out.
+// NOTE: Requires ENABLE_RASTER_MODE. Soft limits apply to the lead-in and lead-out motions.
+// #define ENABLE_RASTER_OVERSCAN // Default disabled. Uncomment to enable.
+
 // Time delay increments performed during a dwell. The default value is set at 50ms, which provides
 // a maximum time delay of roughly 55 minutes, more than enough for most any application. Increasing
 // this delay will increase the maximum dwell time linearly, but also reduces the responsiveness of
@@ -459,8 +575,40 @@
 // 115200 baud will take 5 msec to transmit a typical 55 character report. Worst case reports are
 // around 90-100 characters. As long as the serial TX buffer doesn't get continually maxed, Grbl
 // will continue operating efficiently. Size the TX buffer around the size of a worst-case report.
-// #define RX_BUFFER_SIZE 128 // (1-254) Uncomment to override defaults in serial.h
-// #define TX_BUFFER_SIZE 100 // (1-254)
+// NOTE: On targets with more RAM, either buffer may be set up to several kilobytes to absorb host
+// and USB latency spikes. Sizes over 254 switch the serial ring buffers to 16-bit indices, and the
+// `Bf:` report and binary status frames to 16-bit RX buffer counts.
+// #define RX_BUFFER_SIZE 128 // (1-254, or up to 65534 on larger targets) Uncomment to override defaults in serial.h
+// #define TX_BUFFER_SIZE 100 // (1-254, or up to 65534 on larger targets)
+
+// Enables a binary motion streaming mode alongside the normal ASCII g-code interface. A host enters
+// it by sending the CMD_BINARY_MODE byte at the start of a line, after which each frame carries a
+// packed absolute line motion target in work coordinates, with optional feed rate and spindle speed
+// values and a CRC. Frames go directly to the motion planner without the g-code parser, and are
+// acknowledged in batches of up to BINARY_ACK_BATCH frames with `ok:N`. Realtime commands still
+// work in binary mode. See doc/markdown/binary_streaming.md for the frame format.
+// NOTE: Frames are always in millimeters and absolute work coordinates, regardless of G20 or G91.
+// #define ENABLE_BINARY_STREAMING // Default disabled. Uncomment to enable.
+#define BINARY_ACK_BATCH 8 // (1-255) Max frames acknowledged with one `ok:N` message.
+
+// Enables windowed line acknowledgements for streaming. After a `$W=1` command, Grbl numbers the
+// lines in the order they are received, with the `$W=1` line as 1, and acknowledges successful lines
+// in batches of up to WINDOWED_ACK_BATCH lines with `ok N,P,R`. N is the sequence number of the last
+// line acknowledged, and P and R are the free planner blocks and serial RX bytes. Since the host knows
+// exactly which lines have left the serial RX buffer, it can keep both buffers full with far fewer
+// responses to read. Errors are reported with `error:X` after acknowledging all lines before them.
+// `$W=0` or a reset returns to one `ok` per line. See doc/markdown/interface.md.
+// #define ENABLE_WINDOWED_ACKS // Default disabled. Uncomment to enable.
+#define WINDOWED_ACK_BATCH 8 // (1-255) Max lines acknowledged with one `ok N,P,R` message.
+
+// Enables line number and checksum checks on streamed lines, for reliable streaming at high baud
+// rates. A line sent as `N<line number> ... *<checksum>`, where the checksum is the decimal XOR of
+// all bytes before the '*', is executed only if the checksum matches and the line number follows the
+// last checked line, or is zero to restart the numbering. Otherwise, Grbl sends a `[RS:<line number>]`
+// resend request for the next expected line and `error:18`, and rejects the following lines the same
+// way until the host resends from that line. Lines without a checksum are still accepted, except
+// numbered lines once checksums are in use, since they may have lost their '*'.
+// #define ENABLE_LINE_CHECKSUMS // Default disabled. Uncomment to enable.
 
 // A simple software debouncing feature for hard limit switches. When enabled, the interrupt 
 // monitoring the hard limit switch pins will enable the Arduino's watchdog timer to re-check 
@@ -586,6 +734,83 @@
 // to ensure the laser doesn't inadvertently remain powered while at a stop and cause a fire.
 #define DISABLE_LASER_DURING_HOLD // Default enabled. Comment to disable.
 
+// In M4 dynamic laser mode, scales the laser power of each step segment by the step rate the stepper
+// ISR actually executes it at, i.e. its cycles per step, instead of by the speed at the end of the
+// segment. The step rate is constant within a segment, so the power then tracks the executed velocity
+// exactly through accelerations and decelerations, rather than leading it by up to a segment while
+// speeding up and lagging it while slowing down. Costs one float division per segment.
+// NOTE: Native arc blocks still use the end of segment speed, since their chords have no fixed
+// steps per mm.
+// #define LASER_PWM_STEP_RATE // Default disabled. Uncomment to enable.
+
+// In laser mode, spindle state changes and spindle speed changes without motion normally sync the
+// planner buffer, bringing the machine to a full stop, so the laser output is exactly as programmed
+// while the machine is stationary. Each laser motion already carries its spindle state and speed as
+// planner block conditions, which the stepper applies at the block boundary. This option instead
+// defers the change, if the machine is moving, and applies it once all queued motions have completed.
+// Vector jobs that toggle the laser between shapes then never stop. A dwell still syncs, or carries the
+// spindle state in its dwell block with ENABLE_DWELL_BLOCKS, so the laser output during a G4 is as
+// programmed.
+// #define LASER_SPINDLE_WITHOUT_SYNC // Default disabled. Uncomment to enable.
+
+// Coolant state changes (M7, M8, M9) normally sync the planner buffer, bringing the machine to a full
+// stop, so that the coolant turns on and off exactly where programmed. Every motion already carries the
+// coolant state as its planner block condition. This option has the stepper ISR set the coolant pins
+// when a motion with a different coolant condition than the last one starts executing instead, so a
+// coolant or air assist change between motions costs no stop. A change without a motion following it
+// is applied once all queued motions have completed. A coolant override toggle holds until the next
+// programmed coolant change starts executing.
+// #define COOLANT_WITHOUT_SYNC // Default disabled. Uncomment to enable.
+
+// A G4 dwell normally syncs the planner buffer and then waits in the main program, so no g-code is
+// parsed or planned until the dwell ends, and the motions after it start from an empty buffer. This
+// option queues the dwell in the planner as a block without steps instead, which the stepper segment
+// generator executes as a timed pause. The g-code stream continues into the planner during the dwell,
+// while the motions before and after it still come to a full stop. The spindle PWM and, with
+// COOLANT_WITHOUT_SYNC, the coolant state of the dwell block are held through it. A feed hold pauses
+// the dwell, and the status report shows Run while it executes. Since a dwell no longer syncs, GUIs
+// must not use a `G4 P0.01` to wait for the buffer to empty. Adds 4 bytes of RAM per planner block.
+// #define ENABLE_DWELL_BLOCKS // Default disabled. Uncomment to enable.
+
+// Replaces the linear spindle speed to PWM model with a piecewise-linear calibration curve, for lasers
+// whose output power is far from linear with their PWM duty cycle. The curve has
+// LASER_CALIBRATION_POINTS points, set by the `$40` and up settings, equally spaced across the `$31`
+// to `$30` rpm range. Each point is the PWM output at that speed, in percent of the range between the
+// minimum and maximum PWM values. The defaults closely match the linear model. The curve is
+// converted to PWM values whenever it changes, so each segment only interpolates between two of them.
+// NOTE: Requires VARIABLE_SPINDLE. Adds 4 bytes of RAM per point.
+// #define ENABLE_LASER_CALIBRATION // Default disabled. Uncomment to enable.
+#define LASER_CALIBRATION_POINTS 9 // (2-60) Points
+
+// The 8-bit spindle PWM gives only 255 laser power levels, which can band on greyscale engravings.
+// This option computes PWM values with SPINDLE_PWM_DITHER_BITS more bits of resolution. The timer
+// output compare register still takes the upper 8 bits, while a timer overflow interrupt adds the
+// lower bits to it as a first-order sigma-delta carry every PWM period. The duty cycle averaged over
+// a few PWM periods then has the full resolution. The interrupt only runs while the PWM value has
+// nonzero lower bits.
+// NOTE: Requires VARIABLE_SPINDLE. Doubles the RAM of the raster buffer with ENABLE_RASTER_MODE. Best
+// with a fast PWM frequency, since the averaging period is up to 2^SPINDLE_PWM_DITHER_BITS periods.
+// #define ENABLE_PWM_DITHERING // Default disabled. Uncomment to enable.
+#define SPINDLE_PWM_DITHER_BITS 4 // (1-7) Bits. 4 for 12-bit PWM values.
+
+// Replaces the compile-time spindle PWM frequency, set by SPINDLE_TCCRB_INIT_MASK in cpu_map.h, with
+// the `$33` setting in Hz, so one build can drive laser and spindle drivers with different optimal
+// modulation frequencies. The timer prescaler giving the closest frequency is selected, since the
+// PWM timer only runs at a few fixed frequencies. For the 328p, these are 62.5kHz, 7.8kHz, 1.96kHz,
+// 980Hz, 490Hz, 245Hz, and 61Hz. The default is DEFAULT_SPINDLE_PWM_FREQUENCY in defaults.h.
+// NOTE: Requires VARIABLE_SPINDLE. Adds 4 bytes of EEPROM and RAM for the setting.
+// #define ENABLE_PWM_FREQUENCY_SETTING // Default disabled. Uncomment to enable.
+
+// Adds a pulses-per-inch (PPI) laser mode for CO2 cutting of thin materials. With laser mode and a
+// nonzero `$34` PPI setting, laser motions fire the laser as fixed pulses of `$35` milliseconds at
+// the programmed S power, evenly spaced along the path, instead of a continuous PWM output. The
+// stepper ISR traces the path distance with the Bresenham step events and fires a pulse at each
+// spacing, so the energy per inch stays the same through acceleration, deceleration, and overrides.
+// The pulse width is counted in whole spindle PWM periods by the PWM timer overflow interrupt.
+// NOTE: Requires VARIABLE_SPINDLE. Not compatible with ENABLE_PWM_DITHERING, which uses the same
+// interrupt. Raster scanlines are not pulsed. Adds 8 bytes of EEPROM and RAM for the settings.
+// #define ENABLE_LASER_PPI // Default disabled. Uncomment to enable.
+
 /* ---------------------------------------------------------------------------------------
    OEM Single File Configuration Option
 
@@ -20,6 +20,12 @@
 
 #include "grbl.h"
 
+#ifdef COOLANT_WITHOUT_SYNC
+  // Coolant state to apply once queued motions complete.
+  static uint8_t deferred_state; // Coolant state and DEFERRED_STATE_PENDING flag
+  #define DEFERRED_STATE_PENDING bit(0) // Not a coolant state bit.
+#endif
+
 
 void coolant_init()
 {
@@ -27,6 +33,9 @@ void coolant_init()
   #ifdef ENABLE_M7
     COOLANT_MIST_DDR |= (1 << COOLANT_MIST_BIT);
   #endif
+  #ifdef COOLANT_WITHOUT_SYNC
+    deferred_state = 0;
+  #endif
   coolant_stop();
 }
 
@@ -116,6 +125,25 @@ void coolant_set_state(uint8_t mode)
 void coolant_sync(uint8_t mode)
 {
   if (sys.state == STATE_CHECK_MODE) { return; }
+  #ifdef COOLANT_WITHOUT_SYNC
+    // The stepper sets the coolant of following motions as they start. While moving, only the state
+    // once stopped changes.
+    if (plan_get_current_block() || (sys.state & STATE_CYCLE)) {
+      deferred_state = mode | DEFERRED_STATE_PENDING;
+      return;
+    }
+  #endif
   protocol_buffer_synchronize(); // Ensure coolant turns on when specified in program.
   coolant_set_state(mode);
 }
+
+
+#ifdef COOLANT_WITHOUT_SYNC
+  void coolant_sync_deferred()
+  {
+    if (deferred_state & DEFERRED_STATE_PENDING) {
+      deferred_state &= ~DEFERRED_STATE_PENDING;
+      coolant_set_state(deferred_state);
+    }
+  }
+#endif
@@ -44,4 +44,9 @@ void coolant_set_state(uint8_t mode);
 // G-code parser entry-point for setting coolant states. Checks for and executes additional conditions.
 void coolant_sync(uint8_t mode);
 
+#ifdef COOLANT_WITHOUT_SYNC
+  // Applies a coolant state deferred by coolant_sync(). Called when all motions have completed.
+  void coolant_sync_deferred();
+#endif
+
 #endif
@@ -134,6 +134,11 @@
   #define SPINDLE_TCCRB_REGISTER	  TCCR2B
   #define SPINDLE_OCR_REGISTER      OCR2A
   #define SPINDLE_COMB_BIT	        COM2A1
+  #define SPINDLE_TIMSK_REGISTER    TIMSK2
+  #define SPINDLE_TOIE_BIT          TOIE2
+  #define SPINDLE_TIFR_REGISTER     TIFR2
+  #define SPINDLE_TOV_BIT           TOV2
+  #define SPINDLE_OVF_vect          TIMER2_OVF_vect
 
   // Prescaled, 8-bit Fast PWM mode.
   #define SPINDLE_TCCRA_INIT_MASK   ((1<<WGM20) | (1<<WGM21))  // Configures fast PWM mode.
@@ -142,6 +147,11 @@
   // #define SPINDLE_TCCRB_INIT_MASK   ((1<<CS21) | (1<<CS20)) // 1/32 prescaler -> 1.96kHz
   #define SPINDLE_TCCRB_INIT_MASK      (1<<CS22)               // 1/64 prescaler -> 0.98kHz (J-tech laser)
 
+  // Timer2 prescalers in clock select bits CS22:0 order, starting at 1. Used by the PWM frequency
+  // setting. In fast PWM mode, each PWM period is 256 timer counts.
+  #define SPINDLE_PWM_PRESCALERS    { 1, 8, 32, 64, 128, 256, 1024 }
+  #define SPINDLE_PWM_PERIOD_COUNTS 256
+
   // NOTE: On the 328p, these must be the same as the SPINDLE_ENABLE settings.
   #define SPINDLE_PWM_DDR	  DDRB
   #define SPINDLE_PWM_PORT  PORTB
@@ -452,4 +452,43 @@
   #define DEFAULT_HOMING_PULLOFF 1.0 // mm
 #endif
 
+// Jerk-limited profile defaults. Unless a machine default above sets them, each axis reaches its
+// full acceleration in 0.1 seconds.
+#ifdef JERK_LIMITED_PROFILES
+  #ifndef DEFAULT_X_JERK
+    #define DEFAULT_X_JERK (DEFAULT_X_ACCELERATION*10*60) // mm/min^3
+  #endif
+  #ifndef DEFAULT_Y_JERK
+    #define DEFAULT_Y_JERK (DEFAULT_Y_ACCELERATION*10*60) // mm/min^3
+  #endif
+  #ifndef DEFAULT_Z_JERK
+    #define DEFAULT_Z_JERK (DEFAULT_Z_ACCELERATION*10*60) // mm/min^3
+  #endif
+#endif
+
+// Spindle PWM frequency setting default. Unless a machine default above sets it, matches the
+// SPINDLE_TCCRB_INIT_MASK frequency in cpu_map.h.
+#ifdef ENABLE_PWM_FREQUENCY_SETTING
+  #ifndef DEFAULT_SPINDLE_PWM_FREQUENCY
+    #define DEFAULT_SPINDLE_PWM_FREQUENCY 1000.0 // Hz
+  #endif
+#endif
+
+// Laser PPI mode setting defaults. Pulsing is off until a PPI is set.
+#ifdef ENABLE_LASER_PPI
+  #ifndef DEFAULT_LASER_PPI
+    #define DEFAULT_LASER_PPI 0.0 // pulses/inch. Zero for continuous PWM output.
+  #endif
+  #ifndef DEFAULT_LASER_PULSE_WIDTH
+    #define DEFAULT_LASER_PULSE_WIDTH 1.0 // msec
+  #endif
+#endif
+
+// Automatic status report interval default. Off, until a host sets it.
+#ifdef ENABLE_AUTO_REPORT
+  #ifndef DEFAULT_STATUS_REPORT_INTERVAL
+    #define DEFAULT_STATUS_REPORT_INTERVAL 0.0 // msec. Zero disables automatic reports.
+  #endif
+#endif
+
 #endif
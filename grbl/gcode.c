@@ -58,6 +58,120 @@ void gc_sync_position()
 }
 
 
+#ifdef ENABLE_GCODE_FAST_PATH
+#define FAST_WORD_F N_AXIS // Value indices of the F, S, and N words in gc_execute_fast_line().
+#define FAST_WORD_S (N_AXIS+1)
+#define FAST_WORD_N (N_AXIS+2)
+
+// Executes a block that only continues the current G0 or G1 motion mode in G94 mode, with axis words
+// and optional F, S, and N words, like `X10.5Y2S300`. Skips the full parser steps, which mostly check
+// for commands and modes that such a block can't contain. Returns false without changing anything, if
+// the block is anything else or has any error, so the full parser executes it or reports the error.
+// NOTE: The block must have exactly the same effect as it would have through the full parser.
+static uint8_t gc_execute_fast_line(char *line)
+{
+  if ((gc_state.modal.motion != MOTION_MODE_LINEAR) && (gc_state.modal.motion != MOTION_MODE_SEEK)) { return(false); }
+  if (gc_state.modal.feed_rate != FEED_RATE_MODE_UNITS_PER_MIN) { return(false); }
+
+  // Import the words. Each letter is checked before reading its value, so any other block falls back
+  // to the full parser right away.
+  float values[N_AXIS+3]; // Axis words, followed by the F, S, and N words.
+  uint8_t words = 0; // Bitflags of the words in values.
+  uint8_t idx;
+  uint8_t char_counter = 0;
+  char letter;
+  while ((letter = line[char_counter]) != 0) {
+    switch (letter) {
+      case 'X': idx = X_AXIS; break;
+      case 'Y': idx = Y_AXIS; break;
+      case 'Z': idx = Z_AXIS; break;
+      case 'F': idx = FAST_WORD_F; break;
+      case 'S': idx = FAST_WORD_S; break;
+      case 'N': idx = FAST_WORD_N; break;
+      default: return(false);
+    }
+    char_counter++;
+    if (bit_istrue(words,bit(idx))) { return(false); } // Repeated word
+    if (!read_float(line, &char_counter, &values[idx])) { return(false); }
+    if ((idx >= FAST_WORD_F) && (values[idx] < 0.0)) { return(false); } // Negative F, S, or N
+    words |= bit(idx);
+  }
+  uint8_t axis_words = words & ((1<<N_AXIS)-1);
+  if (!axis_words) { return(false); }
+
+  int32_t line_number = 0;
+  if (bit_istrue(words,bit(FAST_WORD_N))) {
+    line_number = trunc(values[FAST_WORD_N]);
+    if (line_number > MAX_LINE_NUMBER) { return(false); }
+  }
+  float feed_rate = gc_state.feed_rate;
+  if (bit_istrue(words,bit(FAST_WORD_F))) {
+    feed_rate = values[FAST_WORD_F];
+    if (gc_state.modal.units == UNITS_MODE_INCHES) { feed_rate *= MM_PER_INCH; }
+  }
+  if ((gc_state.modal.motion == MOTION_MODE_LINEAR) && (feed_rate == 0.0)) { return(false); }
+  float spindle_speed = gc_state.spindle_speed;
+  if (bit_istrue(words,bit(FAST_WORD_S))) { spindle_speed = values[FAST_WORD_S]; }
+
+  // A spindle speed change syncs the planner buffer, except for laser motions with a variable spindle.
+  uint8_t is_laser_mode = bit_istrue(settings.flags,BITFLAG_LASER_MODE);
+  if ((spindle_speed != gc_state.spindle_speed) && (gc_state.modal.spindle != SPINDLE_DISABLE)) {
+    #ifdef VARIABLE_SPINDLE
+      if (!is_laser_mode) { return(false); }
+    #else
+      return(false);
+    #endif
+  }
+
+  // Compute the target in place of the axis words, exactly as the full parser does.
+  float *xyz = values;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_isfalse(axis_words,bit(idx))) {
+      xyz[idx] = gc_state.position[idx];
+    } else {
+      if (gc_state.modal.units == UNITS_MODE_INCHES) { xyz[idx] *= MM_PER_INCH; }
+      if (gc_state.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+        xyz[idx] += gc_state.coord_system[idx] + gc_state.coord_offset[idx];
+        if (idx == TOOL_LENGTH_OFFSET_AXIS) { xyz[idx] += gc_state.tool_length_offset; }
+      } else {
+        xyz[idx] += gc_state.position[idx];
+      }
+    }
+  }
+
+  // Update the parser state and execute the motion.
+  gc_state.line_number = line_number;
+  gc_state.feed_rate = feed_rate;
+  gc_state.spindle_speed = spindle_speed;
+  gc_state.tool = 0; // As without a T word in the full parser.
+
+  plan_line_data_t plan_data;
+  plan_line_data_t *pl_data = &plan_data;
+  memset(pl_data,0,sizeof(plan_line_data_t));
+  #ifdef USE_LINE_NUMBERS
+    pl_data->line_number = line_number;
+  #endif
+  pl_data->feed_rate = feed_rate;
+  pl_data->condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+  if (gc_state.modal.motion == MOTION_MODE_SEEK) {
+    pl_data->condition |= PL_COND_FLAG_RAPID_MOTION;
+    if (!is_laser_mode) { pl_data->spindle_speed = spindle_speed; } // Laser is off during rapids.
+  } else {
+    pl_data->spindle_speed = spindle_speed;
+  }
+  #ifdef ENABLE_PATH_BLENDING
+    if (gc_state.modal.control == CONTROL_MODE_CONTINUOUS) {
+      if (gc_state.blend_tolerance > 0.0) { pl_data->blend_tolerance = gc_state.blend_tolerance; }
+      else { pl_data->blend_tolerance = settings.junction_deviation; }
+    }
+  #endif
+  mc_line(xyz, pl_data);
+  memcpy(gc_state.position, xyz, sizeof(gc_state.position));
+  return(true);
+}
+#endif
+
+
 // Executes one line of 0-terminated G-Code. The line is assumed to contain only uppercase
 // characters and signed floating point values (no whitespace). Comments and block delete
 // characters have been removed. In this function, all units and positions are converted and
@@ -65,6 +179,10 @@ void gc_sync_position()
 // coordinates, respectively.
 uint8_t gc_execute_line(char *line)
 {
+  #ifdef ENABLE_GCODE_FAST_PATH
+    if (gc_execute_fast_line(line)) { return(STATUS_OK); }
+  #endif
+
   /* -------------------------------------------------------------------------------------
      STEP 1: Initialize parser block struct and copy current g-code state modes. The parser
      updates these modes and commands as the block line is parser and will only be used and
@@ -225,11 +343,20 @@ uint8_t gc_execute_line(char *line)
             word_bit = MODAL_GROUP_G12;
             gc_block.modal.coord_select = int_value - 54; // Shift to array indexing.
             break;
-          case 61:
-            word_bit = MODAL_GROUP_G13;
-            if (mantissa != 0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G61.1 not supported]
-            // gc_block.modal.control = CONTROL_MODE_EXACT_PATH; // G61
-            break;
+          #ifdef ENABLE_PATH_BLENDING
+            case 61: case 64:
+              word_bit = MODAL_GROUP_G13;
+              if (mantissa != 0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G61.1 not supported]
+              if (int_value == 61) { gc_block.modal.control = CONTROL_MODE_EXACT_PATH; } // G61
+              else { gc_block.modal.control = CONTROL_MODE_CONTINUOUS; } // G64
+              break;
+          #else
+            case 61:
+              word_bit = MODAL_GROUP_G13;
+              if (mantissa != 0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G61.1 not supported]
+              // gc_block.modal.control = CONTROL_MODE_EXACT_PATH; // G61
+              break;
+          #endif
           default: FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); // [Unsupported G command]
         }
         if (mantissa > 0) { FAIL(STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER); } // [Unsupported or invalid Gxx.x command]
@@ -510,7 +637,20 @@ uint8_t gc_execute_line(char *line)
     }
   }
 
-  // [16. Set path control mode ]: N/A. Only G61. G61.1 and G64 NOT SUPPORTED.
+  // [16. Set path control mode ]: N/A. Only G61 and, if enabled, G64. G61.1 NOT SUPPORTED.
+  // NOTE: An optional G64 P word sets the path blending tolerance, unless already used by a dwell.
+  // A negative P already failed with STATUS_NEGATIVE_VALUE when parsed. P0 is not an exact path. It
+  // clears the tolerance, so junctions fall back to the $11 junction deviation, like G61.
+  #ifdef ENABLE_PATH_BLENDING
+    float blend_tolerance = gc_state.blend_tolerance; // Keep last tolerance, unless set by P.
+    if (bit_istrue(command_words,bit(MODAL_GROUP_G13)) && (gc_block.modal.control == CONTROL_MODE_CONTINUOUS)) {
+      if (bit_istrue(value_words,bit(WORD_P))) {
+        blend_tolerance = gc_block.values.p;
+        if (gc_block.modal.units == UNITS_MODE_INCHES) { blend_tolerance *= MM_PER_INCH; }
+        bit_false(value_words,bit(WORD_P));
+      }
+    }
+  #endif
   // [17. Set distance mode ]: N/A. Only G91.1. G90.1 NOT SUPPORTED.
   // [18. Set retract mode ]: NOT SUPPORTED.
 
@@ -941,8 +1081,9 @@ uint8_t gc_execute_line(char *line)
   // [7. Spindle control ]:
   if (gc_state.modal.spindle != gc_block.modal.spindle) {
     // Update spindle control and apply spindle speed when enabling it in this block.
-    // NOTE: All spindle state changes are synced, even in laser mode. Also, pl_data,
-    // rather than gc_state, is used to manage laser state for non-laser motions.
+    // NOTE: All spindle state changes are synced, even in laser mode, unless LASER_SPINDLE_WITHOUT_SYNC
+    // defers them while moving. Also, pl_data, rather than gc_state, is used to manage laser state for
+    // non-laser motions.
     spindle_sync(gc_block.modal.spindle, pl_data->spindle_speed);
     gc_state.modal.spindle = gc_block.modal.spindle;
   }
@@ -967,7 +1108,7 @@ uint8_t gc_execute_line(char *line)
   #endif
 
   // [10. Dwell ]:
-  if (gc_block.non_modal_command == NON_MODAL_DWELL) { mc_dwell(gc_block.values.p); }
+  if (gc_block.non_modal_command == NON_MODAL_DWELL) { mc_dwell(gc_block.values.p, pl_data); }
 
   // [11. Set active plane ]:
   gc_state.modal.plane_select = gc_block.modal.plane_select;
@@ -1000,8 +1141,17 @@ uint8_t gc_execute_line(char *line)
     system_flag_wco_change();
   }
 
-  // [16. Set path control mode ]: G61.1/G64 NOT SUPPORTED
-  // gc_state.modal.control = gc_block.modal.control; // NOTE: Always default.
+  // [16. Set path control mode ]: G61.1 NOT SUPPORTED. G64 only if enabled.
+  #ifdef ENABLE_PATH_BLENDING
+    gc_state.modal.control = gc_block.modal.control;
+    if (gc_state.modal.control == CONTROL_MODE_CONTINUOUS) {
+      gc_state.blend_tolerance = blend_tolerance;
+      if (gc_state.blend_tolerance > 0.0) { pl_data->blend_tolerance = gc_state.blend_tolerance; }
+      else { pl_data->blend_tolerance = settings.junction_deviation; }
+    }
+  #else
+    // gc_state.modal.control = gc_block.modal.control; // NOTE: Always default.
+  #endif
 
   // [17. Set distance mode ]:
   gc_state.modal.distance = gc_block.modal.distance;
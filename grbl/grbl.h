@@ -60,6 +60,8 @@
 #include "spindle_control.h"
 #include "stepper.h"
 #include "jog.h"
+#include "binary_stream.h"
+#include "raster.h"
 
 // ---------------------------------------------------------------------------------------
 // COMPILE-TIME ERROR CHECKING OF DEFINE VALUES:
@@ -86,6 +88,70 @@
   #endif
 #endif
 
+#if defined(FIXED_POINT_SEGMENTS) && defined(JERK_LIMITED_PROFILES)
+  #error "FIXED_POINT_SEGMENTS is not supported with JERK_LIMITED_PROFILES at this time."
+#endif
+
+#if defined(ENABLE_RASTER_MODE)
+  #if !defined(VARIABLE_SPINDLE)
+    #error "ENABLE_RASTER_MODE may only be used with VARIABLE_SPINDLE enabled."
+  #endif
+  #if (RASTER_BUFFER_SIZE < LINE_BUFFER_SIZE) || (RASTER_BUFFER_SIZE > 255)
+    #error "RASTER_BUFFER_SIZE must be at least LINE_BUFFER_SIZE and at most 255."
+  #endif
+#endif
+
+#if defined(ENABLE_RASTER_OVERSCAN) && !defined(ENABLE_RASTER_MODE)
+  #error "ENABLE_RASTER_OVERSCAN may only be used with ENABLE_RASTER_MODE enabled."
+#endif
+
+#if (RX_BUFFER_SIZE < 1) || (RX_BUFFER_SIZE > 65534) || (TX_BUFFER_SIZE < 1) || (TX_BUFFER_SIZE > 65534)
+  #error "RX_BUFFER_SIZE and TX_BUFFER_SIZE must be between 1 and 65534."
+#endif
+
+#if defined(ENABLE_LASER_CALIBRATION)
+  #if !defined(VARIABLE_SPINDLE)
+    #error "ENABLE_LASER_CALIBRATION may only be used with VARIABLE_SPINDLE enabled."
+  #endif
+  #if (LASER_CALIBRATION_POINTS < 2) || (LASER_CALIBRATION_POINTS > 60)
+    #error "LASER_CALIBRATION_POINTS must be between 2 and 60."
+  #endif
+#endif
+
+#if defined(ENABLE_PWM_DITHERING)
+  #if !defined(VARIABLE_SPINDLE)
+    #error "ENABLE_PWM_DITHERING may only be used with VARIABLE_SPINDLE enabled."
+  #endif
+  #if (SPINDLE_PWM_DITHER_BITS < 1) || (SPINDLE_PWM_DITHER_BITS > 7)
+    #error "SPINDLE_PWM_DITHER_BITS must be between 1 and 7."
+  #endif
+#endif
+
+#if defined(ENABLE_PWM_FREQUENCY_SETTING) && !defined(VARIABLE_SPINDLE)
+  #error "ENABLE_PWM_FREQUENCY_SETTING may only be used with VARIABLE_SPINDLE enabled."
+#endif
+
+#if defined(ENABLE_BLOCK_QUEUE) && ((BLOCK_QUEUE_SIZE < 1) || (BLOCK_QUEUE_SIZE > 255))
+  #error "BLOCK_QUEUE_SIZE must be between 1 and 255."
+#endif
+
+#if defined(ENABLE_AUTO_REPORT) && defined(ENABLE_SOFTWARE_DEBOUNCE)
+  #error "ENABLE_AUTO_REPORT and ENABLE_SOFTWARE_DEBOUNCE may not be enabled at the same time."
+#endif
+
+#if defined(ENABLE_LASER_PPI)
+  #if !defined(VARIABLE_SPINDLE)
+    #error "ENABLE_LASER_PPI may only be used with VARIABLE_SPINDLE enabled."
+  #endif
+  #if defined(ENABLE_PWM_DITHERING)
+    #error "ENABLE_LASER_PPI and ENABLE_PWM_DITHERING may not be enabled at the same time."
+  #endif
+#endif
+
+#if defined(ENABLE_NATIVE_ARCS) && defined(COREXY)
+  #error "ENABLE_NATIVE_ARCS is not supported with COREXY at this time."
+#endif
+
 #if defined(ENABLE_PARKING_OVERRIDE_CONTROL)
   #if !defined(PARKING_ENABLE)
     #error "ENABLE_PARKING_OVERRIDE_CONTROL must be enabled with PARKING_ENABLE."
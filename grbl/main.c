@@ -31,6 +31,9 @@ volatile uint8_t sys_rt_exec_state;   // Global realtime executor bitflag variab
 volatile uint8_t sys_rt_exec_alarm;   // Global realtime executor bitflag variable for setting various alarms.
 volatile uint8_t sys_rt_exec_motion_override; // Global realtime executor bitflag variable for motion-based overrides.
 volatile uint8_t sys_rt_exec_accessory_override; // Global realtime executor bitflag variable for spindle/coolant overrides.
+#ifdef ENABLE_AUTO_REPORT
+  volatile uint8_t sys_rt_exec_auto_report; // Flags an automatic status report as due.
+#endif
 
 
 int main(void)
@@ -83,12 +86,18 @@ int main(void)
 
     // Reset Grbl primary systems.
     serial_reset_read_buffer(); // Clear serial read buffer
+    #ifdef ENABLE_BINARY_STREAMING
+      binary_stream_init(); // Return to ASCII g-code streaming
+    #endif
     gc_init(); // Set g-code parser to default state
     spindle_init();
     coolant_init();
     limits_init();
     probe_init();
     plan_reset(); // Clear block buffer and planner variables
+    #ifdef ENABLE_BLOCK_QUEUE
+      mc_queue_reset(); // Clear parsed blocks waiting for the planner
+    #endif
     st_reset(); // Clear stepper subsystem variables.
 
     // Sync cleared gcode and planner positions to current system position.
@@ -21,6 +21,99 @@
 
 #include "grbl.h"
 
+#ifdef ENABLE_BLOCK_QUEUE
+  // Parsed blocks waiting for room in the planner buffer, oldest first.
+  typedef struct {
+    float target[N_AXIS];      // Line target. A dwell keeps its time in seconds in the first value.
+    plan_line_data_t pl_data;
+    uint8_t is_dwell;
+  } mc_queue_t;
+  static mc_queue_t mc_queue[BLOCK_QUEUE_SIZE];
+  static uint8_t mc_queue_tail; // Index of the oldest queued block
+  static uint8_t mc_queue_count;
+  #ifdef VARIABLE_SPINDLE
+    static float mc_queue_position[N_AXIS]; // Target of the last queued line.
+  #endif
+
+
+  void mc_queue_reset() { mc_queue_count = 0; }
+
+
+  void mc_queue_flush()
+  {
+    while (mc_queue_count && !plan_check_full_buffer()) {
+      mc_queue_t *block = &mc_queue[mc_queue_tail];
+      #ifdef ENABLE_DWELL_BLOCKS
+        if (block->is_dwell) { plan_buffer_dwell(block->target[0], &block->pl_data); }
+        else { plan_buffer_line(block->target, &block->pl_data); }
+      #else
+        plan_buffer_line(block->target, &block->pl_data);
+      #endif
+      if (++mc_queue_tail == BLOCK_QUEUE_SIZE) { mc_queue_tail = 0; }
+      mc_queue_count--;
+    }
+  }
+
+
+  void mc_queue_synchronize()
+  {
+    while (mc_queue_count) {
+      protocol_execute_realtime(); // Check for any run-time commands
+      if (sys.abort) { return; } // Bail, if system abort.
+      mc_queue_flush();
+      protocol_auto_cycle_start(); // Auto-cycle start, since the planner buffer is full.
+    }
+  }
+
+
+  // Queues a parsed block, if the planner buffer is full or earlier blocks are still queued, waiting
+  // only while the queue is full too. Returns false, if the block may be planned directly instead.
+  static uint8_t mc_queue_block(float *target, plan_line_data_t *pl_data, uint8_t is_dwell)
+  {
+    #ifdef VARIABLE_SPINDLE
+      // An empty line in M3 laser mode sets the spindle state in mc_line() with a buffer sync, so it
+      // is planned directly after the queued blocks, rather than queued.
+      if (!is_dwell && bit_istrue(settings.flags,BITFLAG_LASER_MODE) &&
+          (pl_data->condition & PL_COND_FLAG_SPINDLE_CW)) {
+        float position[N_AXIS];
+        if (mc_queue_count) { memcpy(position, mc_queue_position, sizeof(position)); }
+        else { plan_get_planner_mpos(position); }
+        uint8_t idx;
+        for (idx=0; idx<N_AXIS; idx++) {
+          if (lround(target[idx]*settings.steps_per_mm[idx]) != lround(position[idx]*settings.steps_per_mm[idx])) { break; }
+        }
+        if (idx == N_AXIS) {
+          mc_queue_synchronize();
+          return(sys.abort);
+        }
+      }
+    #endif
+
+    do {
+      protocol_execute_realtime(); // Check for any run-time commands
+      if (sys.abort) { return(true); } // Bail, if system abort.
+      mc_queue_flush();
+      if (!plan_check_full_buffer()) { return(false); } // Queue is empty.
+      protocol_auto_cycle_start(); // Auto-cycle start when buffer is full.
+    } while (mc_queue_count == BLOCK_QUEUE_SIZE);
+
+    uint8_t idx = mc_queue_tail+mc_queue_count;
+    if (idx >= BLOCK_QUEUE_SIZE) { idx -= BLOCK_QUEUE_SIZE; }
+    mc_queue_t *block = &mc_queue[idx];
+    if (is_dwell) { block->target[0] = target[0]; }
+    else {
+      memcpy(block->target, target, sizeof(block->target));
+      #ifdef VARIABLE_SPINDLE
+        memcpy(mc_queue_position, target, sizeof(mc_queue_position));
+      #endif
+    }
+    memcpy(&block->pl_data, pl_data, sizeof(plan_line_data_t));
+    block->is_dwell = is_dwell;
+    mc_queue_count++;
+    return(true);
+  }
+#endif
+
 
 // Execute linear motion in absolute millimeter coordinates. Feed rate given in millimeters/second
 // unless invert_feed_rate is true. Then the feed_rate means that the motion should be completed in
@@ -55,6 +148,24 @@ void mc_line(float *target, plan_line_data_t *pl_data)
   // doesn't update the machine position values. Since the position values used by the g-code
   // parser and planner are separate from the system machine positions, this is doable.
 
+  #ifdef ENABLE_LINE_MERGING
+    // Coalesce nearly collinear short segments into the last planner block, if possible. A merged
+    // line needs no new block, so this is checked before waiting on a full buffer.
+    protocol_execute_realtime(); // Check for any run-time commands
+    if (sys.abort) { return; } // Bail, if system abort.
+    #ifdef ENABLE_BLOCK_QUEUE
+      // Lines only merge into the last planned block, so not while earlier lines are still queued.
+      mc_queue_flush();
+      if ((mc_queue_count == 0) && plan_merge_line(target, pl_data)) { return; }
+    #else
+      if (plan_merge_line(target, pl_data)) { return; }
+    #endif
+  #endif
+
+  #ifdef ENABLE_BLOCK_QUEUE
+    if (mc_queue_block(target, pl_data, false)) { return; }
+  #endif
+
   // If the buffer is full: good! That means we are well ahead of the robot.
   // Remain in this loop until there is room in the buffer.
   do {
@@ -65,8 +176,19 @@ void mc_line(float *target, plan_line_data_t *pl_data)
   } while (1);
 
   // Plan and queue motion into planner buffer
-  // uint8_t plan_status; // Not used in normal operation.
-  plan_buffer_line(target, pl_data);
+  #ifdef VARIABLE_SPINDLE
+    if (plan_buffer_line(target, pl_data) == PLAN_EMPTY_BLOCK) {
+      if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
+        // Correctly set spindle state, if there is a coincident position passed. Forces a buffer
+        // sync while in M3 laser mode only.
+        if (pl_data->condition & PL_COND_FLAG_SPINDLE_CW) {
+          spindle_sync(PL_COND_FLAG_SPINDLE_CW, pl_data->spindle_speed);
+        }
+      }
+    }
+  #else
+    plan_buffer_line(target, pl_data);
+  #endif
 }
 
 
@@ -77,6 +199,8 @@ void mc_line(float *target, plan_line_data_t *pl_data)
 // The arc is approximated by generating a huge number of tiny, linear segments. The chordal tolerance
 // of each segment is configured in settings.arc_tolerance, which is defined to be the maximum normal
 // distance from segment to the circle when the end points both lie on the circle.
+// With ENABLE_NATIVE_ARCS, the arc is planned as a few native arc blocks instead. The stepper segment
+// generator interpolates them into chords within the same arc tolerance.
 void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
   uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc)
 {
@@ -103,6 +227,50 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
                           sqrt(settings.arc_tolerance*(2*radius - settings.arc_tolerance)) );
 
   if (segments) {
+    #ifdef ENABLE_NATIVE_ARCS
+      // Split the arc where it crosses a quadrant boundary of its plane. Every axis extreme of the arc is
+      // then a block end point, which mc_line() checks against soft limits. The last block ends at target.
+      if (pl_data->condition & PL_COND_FLAG_INVERSE_TIME) {
+        // Convert inverse time to the feed rate over the whole arc length, common to all arc blocks.
+        pl_data->feed_rate *= hypot_f(angular_travel*radius, target[axis_linear]-position[axis_linear]);
+        bit_false(pl_data->condition,PL_COND_FLAG_INVERSE_TIME);
+      }
+      pl_data->arc_center[0] = center_axis0;
+      pl_data->arc_center[1] = center_axis1;
+      pl_data->arc_axis_0 = axis_0;
+      pl_data->arc_axis_1 = axis_1;
+      float linear_per_radian = (target[axis_linear] - position[axis_linear])/angular_travel;
+      float angle = atan2(r_axis1, r_axis0);
+      float end_angle = angle + angular_travel;
+      float boundary;
+      int8_t quadrant;
+      if (angular_travel > 0.0) { quadrant = floor(angle/(0.5*M_PI)); }
+      else { quadrant = ceil(angle/(0.5*M_PI)); }
+      for (;;) {
+        if (angular_travel > 0.0) { quadrant++; } else { quadrant--; }
+        boundary = quadrant*(0.5*M_PI);
+        if ((angular_travel > 0.0) ? (boundary >= end_angle) : (boundary <= end_angle)) { break; }
+
+        // Quadrant boundary points lie exactly on the plane axes through the center.
+        position[axis_0] = center_axis0;
+        position[axis_1] = center_axis1;
+        switch (quadrant & 0x03) {
+          case 0: position[axis_0] += radius; break;
+          case 1: position[axis_1] += radius; break;
+          case 2: position[axis_0] -= radius; break;
+          default: position[axis_1] -= radius; // case 3
+        }
+        pl_data->arc_travel = boundary-angle;
+        position[axis_linear] += linear_per_radian*pl_data->arc_travel;
+
+        mc_line(position, pl_data);
+
+        // Bail mid-circle on system abort. Runtime command check already performed by mc_line.
+        if (sys.abort) { return; }
+        angle = boundary;
+      }
+      pl_data->arc_travel = end_angle-angle;
+    #else
     // Multiply inverse feed_rate to compensate for the fact that this movement is approximated
     // by a number of discrete segments. The inverse feed_rate should be correct for the sum of
     // all segments.
@@ -178,6 +346,7 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
       // Bail mid-circle on system abort. Runtime command check already performed by mc_line.
       if (sys.abort) { return; }
     }
+    #endif
   }
   // Ensure last segment arrives at target location.
   mc_line(target, pl_data);
@@ -185,11 +354,25 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
 
 
 // Execute dwell in seconds.
-void mc_dwell(float seconds)
+void mc_dwell(float seconds, plan_line_data_t *pl_data)
 {
   if (sys.state == STATE_CHECK_MODE) { return; }
-  protocol_buffer_synchronize();
-  delay_sec(seconds, DELAY_MODE_DWELL);
+  #ifdef ENABLE_DWELL_BLOCKS
+    // Queue the dwell in the planner like a motion, so the g-code stream is not synced.
+    #ifdef ENABLE_BLOCK_QUEUE
+      if (mc_queue_block(&seconds, pl_data, true)) { return; }
+    #endif
+    do {
+      protocol_execute_realtime(); // Check for any run-time commands
+      if (sys.abort) { return; } // Bail, if system abort.
+      if ( plan_check_full_buffer() ) { protocol_auto_cycle_start(); } // Auto-cycle start when buffer is full.
+      else { break; }
+    } while (1);
+    plan_buffer_dwell(seconds, pl_data);
+  #else
+    protocol_buffer_synchronize();
+    delay_sec(seconds, DELAY_MODE_DWELL);
+  #endif
 }
 
 
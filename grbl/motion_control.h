@@ -45,8 +45,20 @@ void mc_line(float *target, plan_line_data_t *pl_data);
 void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
   uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc);
 
-// Dwell for a specific number of seconds
-void mc_dwell(float seconds);
+// Dwell for a specific number of seconds. pl_data holds the spindle and coolant state to dwell with.
+void mc_dwell(float seconds, plan_line_data_t *pl_data);
+
+#ifdef ENABLE_BLOCK_QUEUE
+  // Clears the parsed block queue. Called upon a system reset and a jog cancel, with the planner.
+  void mc_queue_reset();
+
+  // Moves queued blocks into the planner buffer, while it has room. Called wherever the main program
+  // waits on the planner, so freed planner blocks are refilled right away.
+  void mc_queue_flush();
+
+  // Waits until all queued blocks are in the planner buffer.
+  void mc_queue_synchronize();
+#endif
 
 // Perform homing cycle to locate machine zero. Requires limit switches.
 void mc_homing_cycle(uint8_t cycle_mask);
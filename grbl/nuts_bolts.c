@@ -188,3 +188,17 @@ float limit_value_by_axis_maximum(float *max_value, float *unit_vec)
   }
   return(limit_value);
 }
+
+
+// Updates a CRC-16/XMODEM checksum (CCITT polynomial 0x1021, zero initial value) with one byte.
+// Same as avr-libc's _crc_xmodem_update(), but without relying on the AVR headers.
+uint16_t crc16_update(uint16_t crc, uint8_t data)
+{
+  uint8_t idx;
+  crc ^= ((uint16_t)data << 8);
+  for (idx=0; idx<8; idx++) {
+    if (crc & 0x8000) { crc = (crc << 1) ^ 0x1021; }
+    else { crc <<= 1; }
+  }
+  return(crc);
+}
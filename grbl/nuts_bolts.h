@@ -84,4 +84,7 @@ float hypot_f(float x, float y);
 float convert_delta_vector_to_unit_vector(float *vector);
 float limit_value_by_axis_maximum(float *max_value, float *unit_vec);
 
+// Updates a CRC-16/XMODEM checksum with one byte. Used by the binary serial protocols.
+uint16_t crc16_update(uint16_t crc, uint8_t data);
+
 #endif
@@ -36,6 +36,19 @@ typedef struct {
                                      // i.e. arcs, canned cycles, and backlash compensation.
   float previous_unit_vec[N_AXIS];   // Unit vector of previous path line segment
   float previous_nominal_speed;  // Nominal speed of previous path line segment
+  #ifdef ENABLE_PATH_BLENDING
+    float previous_millimeters;  // Length of previous path line segment
+  #endif
+  #ifdef ENABLE_LINE_MERGING
+    // Planner state before the last block was added. Restored to merge a new line into that block.
+    int32_t merge_position[N_AXIS];
+    float merge_unit_vec[N_AXIS];
+    #ifdef ENABLE_PATH_BLENDING
+      float merge_millimeters;
+    #endif
+    float merge_deviation;     // Max distance of vertices merged into the last block from its line (mm)
+    float merge_entry_speed_sqr; // Entry speed already planned for the block being merged (mm/min)^2
+  #endif
 } planner_t;
 static planner_t pl;
 
@@ -246,6 +259,18 @@ float plan_get_exec_block_exit_speed_sqr()
 }
 
 
+#ifdef JERK_LIMITED_PROFILES
+  // Returns address of the planner block following the given one, or NULL if it is the last block
+  // in the buffer. Used by the stepper segment generator to look ahead for upcoming speed limits.
+  plan_block_t *plan_get_next_block(plan_block_t *block)
+  {
+    uint8_t block_index = plan_next_block_index(block-block_buffer);
+    if (block_index == block_buffer_head) { return(NULL); }
+    return(&block_buffer[block_index]);
+  }
+#endif
+
+
 // Returns the availability status of the block ring buffer. True, if full.
 uint8_t plan_check_full_buffer()
 {
@@ -298,6 +323,66 @@ void plan_update_velocity_profile_parameters()
 }
 
 
+#ifdef ENABLE_NATIVE_ARCS
+  // Computes the arc geometry of an arc block from its start position in steps. The block length becomes
+  // the arc length and unit_vec[] becomes the arc tangent at the start, used for the entry junction. The
+  // tangent at the end is returned in exit_unit_vec[] for the next junction. Axis limits are applied for
+  // the worst case direction along the arc, and the rapid rate, which caps the nominal speed of feed
+  // motions, is reduced so the centripetal acceleration stays within the plane axes acceleration.
+  static void plan_compute_arc_block(plan_block_t *block, plan_line_data_t *pl_data, int32_t *position_steps,
+    float *unit_vec, float *exit_unit_vec)
+  {
+    uint8_t axis_0 = pl_data->arc_axis_0;
+    uint8_t axis_1 = pl_data->arc_axis_1;
+    block->arc_travel = pl_data->arc_travel;
+    block->arc_axis_0 = axis_0;
+    block->arc_axis_1 = axis_1;
+    block->arc_offset[0] = pl_data->arc_center[0]-position_steps[axis_0]/settings.steps_per_mm[axis_0];
+    block->arc_offset[1] = pl_data->arc_center[1]-position_steps[axis_1]/settings.steps_per_mm[axis_1];
+    float radius = hypot_f(block->arc_offset[0], block->arc_offset[1]);
+
+    // Scale the linear axes travel from the chord to the arc length.
+    float chord_mm = block->millimeters;
+    float planar_mm = radius*fabs(block->arc_travel);
+    float linear_mm_sqr = 0.0;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      unit_vec[idx] *= chord_mm; // Linear axes delta in mm
+      if ((idx != axis_0) && (idx != axis_1)) { linear_mm_sqr += unit_vec[idx]*unit_vec[idx]; }
+    }
+    block->millimeters = sqrt(planar_mm*planar_mm + linear_mm_sqr);
+    float limit_vec[N_AXIS];
+    for (idx=0; idx<N_AXIS; idx++) {
+      unit_vec[idx] /= block->millimeters;
+      exit_unit_vec[idx] = unit_vec[idx];
+      limit_vec[idx] = unit_vec[idx];
+    }
+
+    // The tangent is perpendicular to the radius vector from the center, rotated by the arc travel at the end.
+    float planar_fraction = planar_mm/block->millimeters;
+    float tangent_scale = planar_fraction/radius;
+    if (block->arc_travel < 0.0) { tangent_scale = -tangent_scale; }
+    float cos_travel = cos(block->arc_travel);
+    float sin_travel = sin(block->arc_travel);
+    unit_vec[axis_0] = block->arc_offset[1]*tangent_scale;
+    unit_vec[axis_1] = -block->arc_offset[0]*tangent_scale;
+    exit_unit_vec[axis_0] = (block->arc_offset[0]*sin_travel + block->arc_offset[1]*cos_travel)*tangent_scale;
+    exit_unit_vec[axis_1] = (block->arc_offset[1]*sin_travel - block->arc_offset[0]*cos_travel)*tangent_scale;
+
+    // Either plane axis carries all of the planar motion somewhere along an arc.
+    limit_vec[axis_0] = planar_fraction;
+    limit_vec[axis_1] = planar_fraction;
+    block->acceleration = limit_value_by_axis_maximum(settings.acceleration, limit_vec);
+    block->rapid_rate = limit_value_by_axis_maximum(settings.max_rate, limit_vec);
+    #ifdef JERK_LIMITED_PROFILES
+      block->jerk = limit_value_by_axis_maximum(settings.jerk, limit_vec);
+    #endif
+    float centripetal_rate = sqrt(min(settings.acceleration[axis_0],settings.acceleration[axis_1])*radius)/planar_fraction;
+    if (block->rapid_rate > centripetal_rate) { block->rapid_rate = centripetal_rate; }
+  }
+#endif
+
+
 /* Add a new linear movement to the buffer. target[N_AXIS] is the signed, absolute target position
    in millimeters. Feed rate specifies the speed of the motion. If feed rate is inverted, the feed
    rate is taken to mean "frequency" and would complete the operation in 1/feed_rate minutes.
@@ -324,6 +409,9 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
   #ifdef USE_LINE_NUMBERS
     block->line_number = pl_data->line_number;
   #endif
+  #ifdef ENABLE_RASTER_MODE
+    block->raster_pixels = pl_data->raster_pixels;
+  #endif
 
   // Compute and store initial move distance data.
   int32_t target_steps[N_AXIS], position_steps[N_AXIS];
@@ -387,6 +475,13 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
   block->millimeters = convert_delta_vector_to_unit_vector(unit_vec);
   block->acceleration = limit_value_by_axis_maximum(settings.acceleration, unit_vec);
   block->rapid_rate = limit_value_by_axis_maximum(settings.max_rate, unit_vec);
+  #ifdef JERK_LIMITED_PROFILES
+    block->jerk = limit_value_by_axis_maximum(settings.jerk, unit_vec);
+  #endif
+  #ifdef ENABLE_NATIVE_ARCS
+    float exit_unit_vec[N_AXIS];
+    if (pl_data->arc_travel != 0.0) { plan_compute_arc_block(block, pl_data, position_steps, unit_vec, exit_unit_vec); }
+  #endif
 
   // Store programmed rate.
   if (block->condition & PL_COND_FLAG_RAPID_MOTION) { block->programmed_rate = block->rapid_rate; }
@@ -419,7 +514,9 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
     // stop mode (G61.1) manner. In the future, if continuous mode (G64) is desired, the math here
     // is exactly the same. Instead of motioning all the way to junction point, the machine will
     // just follow the arc circle defined here. The Arduino doesn't have the CPU cycles to perform
-    // a continuous mode path, but ARM-based microcontrollers most certainly do.
+    // a continuous mode path, but ARM-based microcontrollers most certainly do. With the
+    // ENABLE_PATH_BLENDING option, G64 uses the blending tolerance as the circle deviation instead,
+    // but the machine still moves through the junction point.
     //
     // NOTE: The max junction speed is a fixed value, since machine acceleration limits cannot be
     // changed dynamically during operation nor can the line move geometry. This must be kept in
@@ -445,10 +542,39 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
         convert_delta_vector_to_unit_vector(junction_unit_vec);
         float junction_acceleration = limit_value_by_axis_maximum(settings.acceleration, junction_unit_vec);
         float sin_theta_d2 = sqrt(0.5*(1.0-junction_cos_theta)); // Trig half angle identity. Always positive.
-        block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
-                       (junction_acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+        #ifdef ENABLE_PATH_BLENDING
+          if (pl_data->blend_tolerance > 0.0) {
+            // Continuous mode (G64). Size the junction for the circle within the blending tolerance of the
+            // corner, but no larger than the circle with its tangent points halfway along either segment.
+            // On dense polylines, the latter limit approaches the curvature of the traced curve.
+            float cos_theta_d2 = sqrt(0.5*(1.0+junction_cos_theta));
+            float blend_radius = (pl_data->blend_tolerance * sin_theta_d2)/(1.0-sin_theta_d2);
+            float max_blend_radius = (0.5*min(pl.previous_millimeters, block->millimeters) * sin_theta_d2)/cos_theta_d2;
+            block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                           junction_acceleration * min(blend_radius, max_blend_radius) );
+          } else {
+            block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                           (junction_acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+          }
+        #else
+          block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                         (junction_acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+        #endif
       }
     }
+    #ifdef ENABLE_LINE_MERGING
+      // A merged block keeps at least the entry speed already planned for it. The blocks before it
+      // may be committed to exit at that speed, and its direction only changed within the tolerance.
+      if (block->max_junction_speed_sqr < pl.merge_entry_speed_sqr) {
+        block->max_junction_speed_sqr = pl.merge_entry_speed_sqr;
+      }
+    #endif
+    #ifdef ENABLE_DWELL_BLOCKS
+      // Motions after a dwell block start from rest.
+      if (block_buffer[plan_prev_block_index(block_buffer_head)].step_event_count == 0) {
+        block->max_junction_speed_sqr = 0.0;
+      }
+    #endif
   }
 
   // Block system motion from updating this data to ensure next g-code motion is computed correctly.
@@ -456,10 +582,30 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
     float nominal_speed = plan_compute_profile_nominal_speed(block);
     plan_compute_profile_parameters(block, nominal_speed, pl.previous_nominal_speed);
     pl.previous_nominal_speed = nominal_speed;
+    #ifdef ENABLE_LINE_MERGING
+      // Save planner state for merging subsequent lines into this block.
+      memcpy(pl.merge_position, pl.position, sizeof(pl.position));
+      memcpy(pl.merge_unit_vec, pl.previous_unit_vec, sizeof(pl.previous_unit_vec));
+      #ifdef ENABLE_PATH_BLENDING
+        pl.merge_millimeters = pl.previous_millimeters;
+      #endif
+      pl.merge_deviation = 0.0;
+    #endif
+    #ifdef ENABLE_PATH_BLENDING
+      pl.previous_millimeters = block->millimeters;
+    #endif
 
     // Update previous path unit_vector and planner position.
-    memcpy(pl.previous_unit_vec, unit_vec, sizeof(unit_vec)); // pl.previous_unit_vec[] = unit_vec[]
+    #ifdef ENABLE_NATIVE_ARCS
+      if (block->arc_travel != 0.0) { memcpy(pl.previous_unit_vec, exit_unit_vec, sizeof(exit_unit_vec)); }
+      else { memcpy(pl.previous_unit_vec, unit_vec, sizeof(unit_vec)); }
+    #else
+      memcpy(pl.previous_unit_vec, unit_vec, sizeof(unit_vec)); // pl.previous_unit_vec[] = unit_vec[]
+    #endif
     memcpy(pl.position, target_steps, sizeof(target_steps)); // pl.position[] = target_steps[]
+    #ifdef ENABLE_RASTER_MODE
+      if (block->raster_pixels) { st_raster_buffer_commit(block->raster_pixels); }
+    #endif
 
     // New block is all set. Update buffer head and next buffer head indices.
     block_buffer_head = next_buffer_head;
@@ -472,6 +618,169 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
 }
 
 
+#ifdef ENABLE_LINE_MERGING
+  // Merges a new line motion into the last block in the buffer, if the last block is not yet executing
+  // and the line continues it within the merge tolerance. The last block is removed and replanned as a
+  // single line from its start position to the new target. Returns true, if the line was merged.
+  // NOTE: Checks are made in millimeters from the planner step positions. The deviation bound adds up
+  // how far the line direction has swung about its start, which covers all vertices merged before.
+  uint8_t plan_merge_line(float *target, plan_line_data_t *pl_data)
+  {
+    if (block_buffer_head == block_buffer_tail) { return(false); } // Buffer empty.
+    uint8_t block_index = plan_prev_block_index(block_buffer_head);
+    if (block_index == block_buffer_tail) { return(false); } // Last block may be executing.
+
+    // Only merge lines with identical run conditions and rates.
+    plan_block_t *block = &block_buffer[block_index];
+    if (pl_data->condition & (PL_COND_FLAG_SYSTEM_MOTION|PL_COND_FLAG_INVERSE_TIME)) { return(false); }
+    if (block->condition != pl_data->condition) { return(false); }
+    if (!(block->condition & PL_COND_FLAG_RAPID_MOTION)) {
+      if (block->programmed_rate != pl_data->feed_rate) { return(false); }
+    }
+    #ifdef VARIABLE_SPINDLE
+      if (block->spindle_speed != pl_data->spindle_speed) { return(false); }
+    #endif
+    #ifdef ENABLE_NATIVE_ARCS
+      if ((block->arc_travel != 0.0) || (pl_data->arc_travel != 0.0)) { return(false); } // Lines only.
+    #endif
+    #ifdef ENABLE_RASTER_MODE
+      if (block->raster_pixels || pl_data->raster_pixels) { return(false); } // Pixels fixed to each block.
+    #endif
+    #ifdef ENABLE_DWELL_BLOCKS
+      if (block->step_event_count == 0) { return(false); } // Dwell block.
+    #endif
+
+    // Compute the last block line, the new segment, and the merged line from the block start.
+    float line_vec[N_AXIS], merge_vec[N_AXIS];
+    float line_mm = 0.0, segment_mm = 0.0, merge_mm = 0.0, segment_dot = 0.0, merge_dot = 0.0;
+    float start_mm, delta_mm;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      start_mm = pl.merge_position[idx]/settings.steps_per_mm[idx];
+      line_vec[idx] = (pl.position[idx]-pl.merge_position[idx])/settings.steps_per_mm[idx];
+      merge_vec[idx] = target[idx]-start_mm;
+      delta_mm = merge_vec[idx]-line_vec[idx];
+      line_mm += line_vec[idx]*line_vec[idx];
+      segment_mm += delta_mm*delta_mm;
+      merge_mm += merge_vec[idx]*merge_vec[idx];
+      segment_dot += delta_mm*line_vec[idx];
+      merge_dot += merge_vec[idx]*line_vec[idx];
+    }
+    line_mm = sqrt(line_mm);
+    segment_mm = sqrt(segment_mm);
+    merge_mm = sqrt(merge_mm);
+    if (merge_mm == 0.0) { return(false); }
+
+    // The new segment must not turn more than the max angle from the last block line.
+    if (segment_dot < cos(LINE_MERGE_MAX_ANGLE)*segment_mm*line_mm) { return(false); }
+
+    // Distance of the last block end point from the merged line bounds the added deviation.
+    float deviation = 0.0;
+    merge_dot /= merge_mm*merge_mm;
+    for (idx=0; idx<N_AXIS; idx++) {
+      delta_mm = line_vec[idx]-merge_dot*merge_vec[idx];
+      deviation += delta_mm*delta_mm;
+    }
+    deviation = pl.merge_deviation+sqrt(deviation);
+    if (deviation > LINE_MERGE_TOLERANCE) { return(false); }
+
+    // Remove the last block and restore the planner state before it. The block before it keeps its plan.
+    if (block_buffer_planned == block_index) { block_buffer_planned = plan_prev_block_index(block_index); }
+    pl.merge_entry_speed_sqr = block->entry_speed_sqr;
+    block_buffer_head = block_index;
+    next_buffer_head = plan_next_block_index(block_buffer_head);
+    memcpy(pl.position, pl.merge_position, sizeof(pl.position));
+    memcpy(pl.previous_unit_vec, pl.merge_unit_vec, sizeof(pl.previous_unit_vec));
+    #ifdef ENABLE_PATH_BLENDING
+      pl.previous_millimeters = pl.merge_millimeters;
+    #endif
+    pl.previous_nominal_speed = plan_compute_profile_nominal_speed(&block_buffer[plan_prev_block_index(block_index)]);
+
+    // Replan the merged line. If it rounds to no steps, close the last block to further merges.
+    if (plan_buffer_line(target, pl_data) == PLAN_OK) { pl.merge_deviation = deviation; }
+    else { pl.merge_deviation = SOME_LARGE_VALUE; }
+    pl.merge_entry_speed_sqr = 0.0;
+    return(true);
+  }
+#endif
+
+
+#ifdef ENABLE_RASTER_OVERSCAN
+  plan_block_t *plan_get_last_block()
+  {
+    if (block_buffer_head == block_buffer_tail) { return(NULL); } // Buffer empty.
+    uint8_t block_index = plan_prev_block_index(block_buffer_head);
+    if (block_index == block_buffer_tail) { return(NULL); } // Last block may be executing.
+    return(&block_buffer[block_index]);
+  }
+
+
+  void plan_discard_last_block()
+  {
+    uint8_t block_index = plan_prev_block_index(block_buffer_head);
+    plan_block_t *block = &block_buffer[block_index];
+
+    // Step the planner position back by the block steps.
+    int32_t delta_steps[N_AXIS];
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      delta_steps[idx] = block->steps[idx];
+      if (block->direction_bits & get_direction_pin_mask(idx)) { delta_steps[idx] = -delta_steps[idx]; }
+    }
+    #ifdef COREXY
+      pl.position[X_AXIS] -= (delta_steps[A_MOTOR] + delta_steps[B_MOTOR])/2;
+      pl.position[Y_AXIS] -= (delta_steps[A_MOTOR] - delta_steps[B_MOTOR])/2;
+      pl.position[Z_AXIS] -= delta_steps[Z_AXIS];
+    #else
+      for (idx=0; idx<N_AXIS; idx++) { pl.position[idx] -= delta_steps[idx]; }
+    #endif
+
+    // Remove the block. The blocks before it are replanned with the next block added.
+    if (block_buffer_planned == block_index) { block_buffer_planned = plan_prev_block_index(block_index); }
+    block_buffer_head = block_index;
+    next_buffer_head = plan_next_block_index(block_buffer_head);
+    pl.previous_nominal_speed = plan_compute_profile_nominal_speed(&block_buffer[plan_prev_block_index(block_index)]);
+  }
+#endif
+
+
+#ifdef ENABLE_DWELL_BLOCKS
+  // Adds a dwell block to the buffer. The block has no steps and no junction speed, so the planner
+  // stops motions before it, and the stepper segment generator executes it as a timed pause. The
+  // planner position and previous path direction are unchanged.
+  uint8_t plan_buffer_dwell(float seconds, plan_line_data_t *pl_data)
+  {
+    uint32_t dwell_ms = lround(1000.0*seconds);
+    if (dwell_ms == 0) { return(PLAN_EMPTY_BLOCK); }
+
+    plan_block_t *block = &block_buffer[block_buffer_head];
+    memset(block,0,sizeof(plan_block_t)); // Zero all block values. Entry speeds are zero.
+    block->condition = pl_data->condition & PL_COND_ACCESSORY_MASK;
+    block->dwell_ms = dwell_ms;
+    #ifdef VARIABLE_SPINDLE
+      block->spindle_speed = pl_data->spindle_speed;
+    #endif
+    #ifdef USE_LINE_NUMBERS
+      block->line_number = pl_data->line_number;
+    #endif
+    pl.previous_nominal_speed = 0.0;
+
+    block_buffer_head = next_buffer_head;
+    next_buffer_head = plan_next_block_index(block_buffer_head);
+    planner_recalculate();
+    return(PLAN_OK);
+  }
+#endif
+
+
+// Returns the planner position after the last planned block, in machine coordinates and mm.
+void plan_get_planner_mpos(float *target)
+{
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) { target[idx] = pl.position[idx]/settings.steps_per_mm[idx]; }
+}
+
+
 // Reset the planner position vectors. Called by the system abort/initialization routine.
 void plan_sync_position()
 {
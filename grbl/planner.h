@@ -70,6 +70,9 @@ typedef struct {
   float max_entry_speed_sqr; // Maximum allowable entry speed based on the minimum of junction limit and
                              //   neighboring nominal speeds with overrides in (mm/min)^2
   float acceleration;        // Axis-limit adjusted line acceleration in (mm/min^2). Does not change.
+  #ifdef JERK_LIMITED_PROFILES
+    float jerk;              // Axis-limit adjusted line jerk in (mm/min^3). Does not change.
+  #endif
   float millimeters;         // The remaining distance for this block to be executed in (mm).
                              // NOTE: This value may be altered by stepper algorithm during execution.
 
@@ -82,6 +85,22 @@ typedef struct {
     // Stored spindle speed data used by spindle overrides and resuming methods.
     float spindle_speed;    // Block spindle speed. Copied from pl_line_data.
   #endif
+
+  #ifdef ENABLE_NATIVE_ARCS
+    // Arc geometry used by the stepper segment generator to interpolate arc blocks.
+    float arc_travel;       // Signed angular travel in radians. Positive is CCW. Zero for a line.
+    float arc_offset[2];    // Arc center relative to the block start position in the arc plane (mm)
+    uint8_t arc_axis_0;     // Axes of the arc plane. All other axes travel linearly with the arc.
+    uint8_t arc_axis_1;
+  #endif
+
+  #ifdef ENABLE_RASTER_MODE
+    uint8_t raster_pixels;  // Number of raster scanline pixels. Zero if not a raster block.
+  #endif
+
+  #ifdef ENABLE_DWELL_BLOCKS
+    uint32_t dwell_ms;      // Remaining dwell time in milliseconds. Dwell blocks have no steps.
+  #endif
 } plan_block_t;
 
 
@@ -93,6 +112,18 @@ typedef struct {
   #ifdef USE_LINE_NUMBERS
     int32_t line_number;    // Desired line number to report when executing.
   #endif
+  #ifdef ENABLE_PATH_BLENDING
+    float blend_tolerance;  // G64 path blending tolerance in mm. Zero for exact path mode (G61).
+  #endif
+  #ifdef ENABLE_NATIVE_ARCS
+    float arc_travel;       // Signed angular travel of an arc motion in radians. Zero for a line.
+    float arc_center[2];    // Absolute arc center position in the arc plane (mm)
+    uint8_t arc_axis_0;     // Axes of the arc plane.
+    uint8_t arc_axis_1;
+  #endif
+  #ifdef ENABLE_RASTER_MODE
+    uint8_t raster_pixels;  // Number of raster pixels written to the raster buffer for this line.
+  #endif
 } plan_line_data_t;
 
 
@@ -105,6 +136,28 @@ void plan_reset_buffer(); // Reset buffer only.
 // rate is taken to mean "frequency" and would complete the operation in 1/feed_rate minutes.
 uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data);
 
+#ifdef ENABLE_LINE_MERGING
+  // Merges a line motion into the last buffered block, if it continues it within the merge tolerance.
+  // Returns true, if merged. Otherwise, the line must be added with plan_buffer_line().
+  uint8_t plan_merge_line(float *target, plan_line_data_t *pl_data);
+#endif
+
+#ifdef ENABLE_RASTER_OVERSCAN
+  // Returns the last block in the buffer, if it is not executing. Otherwise, returns NULL.
+  plan_block_t *plan_get_last_block();
+
+  // Removes the last block, which must be one returned by plan_get_last_block(), and moves the planner
+  // position back to its start. The path direction is not restored, so the block before it must end
+  // in the same direction.
+  void plan_discard_last_block();
+#endif
+
+#ifdef ENABLE_DWELL_BLOCKS
+  // Adds a G4 dwell to the buffer as a block without steps. Motions stop before and after the dwell,
+  // and the spindle and coolant states of pl_data are held through it.
+  uint8_t plan_buffer_dwell(float seconds, plan_line_data_t *pl_data);
+#endif
+
 // Called when the current block is no longer needed. Discards the block and makes the memory
 // availible for new blocks.
 void plan_discard_current_block();
@@ -121,6 +174,11 @@ uint8_t plan_next_block_index(uint8_t block_index);
 // Called by step segment buffer when computing executing block velocity profile.
 float plan_get_exec_block_exit_speed_sqr();
 
+#ifdef JERK_LIMITED_PROFILES
+  // Called by step segment buffer to look ahead at the block following the given one.
+  plan_block_t *plan_get_next_block(plan_block_t *block);
+#endif
+
 // Called by main program during planner calculations and step segment buffer during initialization.
 float plan_compute_profile_nominal_speed(plan_block_t *block);
 
@@ -143,6 +201,7 @@ uint8_t plan_get_block_buffer_count();
 // Returns the status of the block ring buffer. True, if buffer is full.
 uint8_t plan_check_full_buffer();
 
+// Returns the planner position after the last planned block, in machine coordinates and mm.
 void plan_get_planner_mpos(float *target);
 
 
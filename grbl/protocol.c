@@ -30,6 +30,13 @@
 static char line[LINE_BUFFER_SIZE]; // Line to be executed. Zero-terminated.
 
 static void protocol_exec_rt_suspend();
+#ifdef ENABLE_WINDOWED_ACKS
+  static void protocol_check_ack();
+#endif
+#ifdef ENABLE_LINE_CHECKSUMS
+  static uint8_t protocol_check_line(uint8_t checksum, uint8_t checksum_index);
+#endif
+static void protocol_report_line_status(uint8_t status_code);
 
 
 /*
@@ -71,11 +78,29 @@ void protocol_main_loop()
   uint8_t line_flags = 0;
   uint8_t char_counter = 0;
   uint8_t c;
+  #ifdef ENABLE_LINE_CHECKSUMS
+    uint8_t line_checksum = 0;  // XOR of the bytes received before the checksum.
+    uint8_t checksum_index = 0; // Line index after the '*' starting the checksum. Zero, if none.
+  #endif
   for (;;) {
 
     // Process one line of incoming serial data, as the data becomes available. Performs an
     // initial filtering by removing spaces and comments and capitalizing all letters.
     while((c = serial_read()) != SERIAL_NO_DATA) {
+      #ifdef ENABLE_BINARY_STREAMING
+        if (binary_stream_is_active()) {
+          if (binary_stream_read(c)) { // End of frame reached
+            protocol_execute_realtime(); // Runtime command check point.
+            if (sys.abort) { return; } // Bail to calling function upon system abort
+            binary_stream_execute_frame();
+          }
+          continue;
+        }
+        if ((c == CMD_BINARY_MODE) && (char_counter == 0) && (line_flags == 0)) {
+          binary_stream_start(); // Binary frames follow. Only valid at the start of a line.
+          continue;
+        }
+      #endif
       if ((c == '\n') || (c == '\r')) { // End of line reached
 
         protocol_execute_realtime(); // Runtime command check point.
@@ -87,29 +112,52 @@ void protocol_main_loop()
         #endif
 
         // Direct and execute one line of formatted input, and report status of execution.
+        uint8_t status_code;
         if (line_flags & LINE_FLAG_OVERFLOW) {
           // Report line overflow error.
-          report_status_message(STATUS_OVERFLOW);
+          status_code = STATUS_OVERFLOW;
+        #ifdef ENABLE_LINE_CHECKSUMS
+          } else if ((status_code = protocol_check_line(line_checksum, checksum_index)) != STATUS_OK) {
+            // Corrupted or out of sequence line. Not executed, so the host can resend it.
+        #endif
         } else if (line[0] == 0) {
           // Empty or comment line. For syncing purposes.
-          report_status_message(STATUS_OK);
+          status_code = STATUS_OK;
         } else if (line[0] == '$') {
           // Grbl '$' system command
-          report_status_message(system_execute_line(line));
+          #ifdef ENABLE_WINDOWED_ACKS
+            protocol_flush_ack(); // Acknowledge earlier lines before any messages the command prints.
+          #endif
+          status_code = system_execute_line(line);
         } else if (sys.state & (STATE_ALARM | STATE_JOG)) {
           // Everything else is gcode. Block if in alarm or jog mode.
-          report_status_message(STATUS_SYSTEM_GC_LOCK);
+          status_code = STATUS_SYSTEM_GC_LOCK;
         } else {
           // Parse and execute g-code block.
-          report_status_message(gc_execute_line(line));
+          status_code = gc_execute_line(line);
         }
+        protocol_report_line_status(status_code);
 
         // Reset tracking data for next line.
         line_flags = 0;
         char_counter = 0;
+        #ifdef ENABLE_LINE_CHECKSUMS
+          line_checksum = 0;
+          checksum_index = 0;
+        #endif
 
       } else {
 
+        #ifdef ENABLE_LINE_CHECKSUMS
+          // The checksum covers every byte sent before the first '*' outside a comment.
+          if (!checksum_index) {
+            if ((c == '*') && !(line_flags & (LINE_FLAG_COMMENT_PARENTHESES | LINE_FLAG_COMMENT_SEMICOLON))) {
+              checksum_index = char_counter+1; // The '*' is kept in the line, and is stripped after checking.
+            } else {
+              line_checksum ^= c;
+            }
+          }
+        #endif
         if (line_flags) {
           // Throw away all (except EOL) comment characters and overflow characters.
           if (c == ')') {
@@ -154,6 +202,12 @@ void protocol_main_loop()
     // If there are no more characters in the serial read buffer to be processed and executed,
     // this indicates that g-code streaming has either filled the planner buffer or has
     // completed. In either case, auto-cycle start, if enabled, any queued moves.
+    #ifdef ENABLE_BINARY_STREAMING
+      binary_stream_flush_ack(); // Acknowledge remaining frames, so the host sends more.
+    #endif
+    #ifdef ENABLE_BLOCK_QUEUE
+      mc_queue_flush(); // Refill the planner buffer while waiting for more lines.
+    #endif
     protocol_auto_cycle_start();
 
     protocol_execute_realtime();  // Runtime command check point.
@@ -164,6 +218,69 @@ void protocol_main_loop()
 }
 
 
+// Reports the status of an executed line.
+static void protocol_report_line_status(uint8_t status_code)
+{
+  #ifdef ENABLE_WINDOWED_ACKS
+    if (sys.ack_windowed) {
+      if (status_code == STATUS_OK) {
+        sys.ack_count++;
+        protocol_check_ack();
+        return;
+      }
+      // Errors are reported in order, after any pending acknowledgements.
+      protocol_flush_ack();
+      sys.ack_sequence++;
+    }
+  #endif
+  #ifdef ENABLE_LINE_CHECKSUMS
+    if (status_code == STATUS_LINE_RESEND) { report_line_resend(sys.line_number_last+1); }
+  #endif
+  report_status_message(status_code);
+}
+
+
+#ifdef ENABLE_LINE_CHECKSUMS
+  // Checks a line sent as `N<line number> ... *<checksum>`, where the checksum is the XOR of all bytes
+  // before the '*', and strips the checksum. Returns STATUS_LINE_RESEND, if the line is corrupted or
+  // not numbered after the last checked line. Lines without a checksum pass unchecked.
+  static uint8_t protocol_check_line(uint8_t checksum, uint8_t checksum_index)
+  {
+    if (!checksum_index) {
+      // Once checksums are in use, a numbered line without one may have lost its '*'.
+      if ((line[0] == 'N') && sys.line_checked) { return(STATUS_LINE_RESEND); }
+      return(STATUS_OK);
+    }
+
+    // Checksum must be a single decimal byte value and end the line.
+    char *ptr = &line[checksum_index];
+    if (*ptr == 0) { return(STATUS_LINE_RESEND); }
+    uint16_t value = 0;
+    while (*ptr != 0) {
+      if ((*ptr < '0') || (*ptr > '9') || (value > 25)) { return(STATUS_LINE_RESEND); }
+      value = 10*value + (*ptr++ - '0');
+    }
+    if (value != checksum) { return(STATUS_LINE_RESEND); }
+    line[checksum_index-1] = 0; // Strip checksum.
+
+    // Line number must follow the last one. Zero restarts the numbering.
+    if (line[0] != 'N') { return(STATUS_LINE_RESEND); }
+    uint8_t char_counter = 1;
+    float number;
+    if (!read_float(line, &char_counter, &number)) { return(STATUS_LINE_RESEND); }
+    int32_t line_number = trunc(number);
+    if ((number < 0.0) || (number != line_number)) { return(STATUS_LINE_RESEND); }
+    if (line_number && (line_number != sys.line_number_last+1)) { return(STATUS_LINE_RESEND); }
+    sys.line_checked = true;
+    sys.line_number_last = line_number;
+
+    // A numbered system command executes without its line number.
+    if (line[char_counter] == '$') { memmove(line, &line[char_counter], strlen(&line[char_counter])+1); }
+    return(STATUS_OK);
+  }
+#endif
+
+
 // Block until all buffered steps are executed or in a cycle state. Works with feed hold
 // during a synchronize call, if it should happen. Also, waits for clean cycle end.
 void protocol_buffer_synchronize()
@@ -173,6 +290,9 @@ void protocol_buffer_synchronize()
   do {
     protocol_execute_realtime();   // Check and execute run-time commands
     if (sys.abort) { return; } // Check for system abort
+    #ifdef ENABLE_BLOCK_QUEUE
+      mc_queue_flush();
+    #endif
   } while (plan_get_current_block() || (sys.state == STATE_CYCLE));
 }
 
@@ -185,12 +305,37 @@ void protocol_buffer_synchronize()
 // execute calls a buffer sync, or the planner buffer is full and ready to go.
 void protocol_auto_cycle_start()
 {
+  #ifdef ENABLE_WINDOWED_ACKS
+    protocol_check_ack(); // Grbl may wait here for a while. Let the host refill the serial read buffer.
+  #endif
   if (plan_get_current_block() != NULL) { // Check if there are any blocks in the buffer.
     system_set_exec_state_flag(EXEC_CYCLE_START); // If so, execute them!
   }
 }
 
 
+#ifdef ENABLE_WINDOWED_ACKS
+  void protocol_flush_ack()
+  {
+    if (sys.ack_count) {
+      sys.ack_sequence += sys.ack_count;
+      sys.ack_count = 0;
+      report_windowed_ack(sys.ack_sequence);
+    }
+  }
+
+
+  // Acknowledges the executed lines once a batch is complete, or once the serial read buffer is more
+  // than half empty, so the host refills it well before it runs dry.
+  static void protocol_check_ack()
+  {
+    if ((sys.ack_count >= WINDOWED_ACK_BATCH) || (serial_get_rx_buffer_available() > (RX_BUFFER_SIZE/2))) {
+      protocol_flush_ack();
+    }
+  }
+#endif
+
+
 // This function is the general interface to Grbl's real-time command execution system. It is called
 // from various check points in the main program, primarily where there may be a while loop waiting
 // for a buffer to clear space or any point where the execution time from the last check point may
@@ -385,6 +530,9 @@ void protocol_exec_rt_system()
         if (sys.suspend & SUSPEND_JOG_CANCEL) {   // For jog cancel, flush buffers and sync positions.
           sys.step_control = STEP_CONTROL_NORMAL_OP;
           plan_reset();
+          #ifdef ENABLE_BLOCK_QUEUE
+            mc_queue_reset();
+          #endif
           st_reset();
           gc_sync_position();
           plan_sync_position();
@@ -397,6 +545,14 @@ void protocol_exec_rt_system()
           sys.suspend = SUSPEND_DISABLE;
           sys.state = STATE_IDLE;
         }
+        if (plan_get_current_block() == NULL) { // All motions complete.
+          #ifdef LASER_SPINDLE_WITHOUT_SYNC
+            spindle_sync_deferred();
+          #endif
+          #ifdef COOLANT_WITHOUT_SYNC
+            coolant_sync_deferred();
+          #endif
+        }
       }
       system_clear_exec_state_flag(EXEC_CYCLE_STOP);
     }
@@ -460,7 +616,9 @@ void protocol_exec_rt_system()
     }
 
     // NOTE: Since coolant state always performs a planner sync whenever it changes, the current
-    // run state can be determined by checking the parser state.
+    // run state can be determined by checking the parser state. With COOLANT_WITHOUT_SYNC, queued
+    // motions carry the coolant state of the parser when they were planned, and the stepper only sets
+    // it again when a motion with a different state starts. So, the toggled parser state holds.
     if (rt_exec & (EXEC_COOLANT_FLOOD_OVR_TOGGLE | EXEC_COOLANT_MIST_OVR_TOGGLE)) {
       if ((sys.state == STATE_IDLE) || (sys.state & (STATE_CYCLE | STATE_HOLD))) {
         uint8_t coolant_state = gc_state.modal.coolant;
@@ -490,6 +648,15 @@ void protocol_exec_rt_system()
     }
   #endif
 
+  #ifdef ENABLE_AUTO_REPORT
+    // Send a due automatic status report once the serial TX buffer has drained, so it never delays the
+    // responses to streamed lines.
+    if (sys_rt_exec_auto_report && (serial_get_tx_buffer_count() == 0)) {
+      sys_rt_exec_auto_report = false;
+      report_auto_status();
+    }
+  #endif
+
   // Reload step segment buffer
   if (sys.state & (STATE_CYCLE | STATE_HOLD | STATE_SAFETY_DOOR | STATE_HOMING | STATE_SLEEP| STATE_JOG)) {
     st_prep_buffer();
@@ -664,7 +831,9 @@ static void protocol_exec_rt_suspend()
             #endif
 
             // Delayed Tasks: Restart spindle and coolant, delay to power-up, then resume cycle.
-            if (gc_state.modal.spindle != SPINDLE_DISABLE) {
+            // NOTE: With LASER_SPINDLE_WITHOUT_SYNC, the parser spindle state may already differ from
+            // the interrupted motion. So, restore the spindle state of the motion.
+            if (restore_condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) {
               // Block if safety door re-opened during prior restore actions.
               if (bit_isfalse(sys.suspend,SUSPEND_RESTART_RETRACT)) {
                 if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
@@ -676,11 +845,13 @@ static void protocol_exec_rt_suspend()
                 }
               }
             }
-            if (gc_state.modal.coolant != COOLANT_DISABLE) {
+            // NOTE: With COOLANT_WITHOUT_SYNC, the parser coolant state may already differ from the
+            // interrupted motion. So, restore the coolant state of the motion.
+            if (restore_condition & (PL_COND_FLAG_COOLANT_FLOOD | PL_COND_FLAG_COOLANT_MIST)) {
               // Block if safety door re-opened during prior restore actions.
               if (bit_isfalse(sys.suspend,SUSPEND_RESTART_RETRACT)) {
                 // NOTE: Laser mode will honor this delay. An exhaust system is often controlled by this pin.
-                coolant_set_state((restore_condition & (PL_COND_FLAG_COOLANT_FLOOD | PL_COND_FLAG_COOLANT_FLOOD)));
+                coolant_set_state((restore_condition & (PL_COND_FLAG_COOLANT_FLOOD | PL_COND_FLAG_COOLANT_MIST)));
                 delay_sec(SAFETY_DOOR_COOLANT_DELAY, DELAY_MODE_SYS_SUSPEND);
               }
             }
@@ -730,7 +901,7 @@ static void protocol_exec_rt_suspend()
             }
           // Handles restoring of spindle state
           } else if (sys.spindle_stop_ovr & (SPINDLE_STOP_OVR_RESTORE | SPINDLE_STOP_OVR_RESTORE_CYCLE)) {
-            if (gc_state.modal.spindle != SPINDLE_DISABLE) {
+            if (restore_condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) {
               report_feedback_message(MESSAGE_SPINDLE_RESTORE);
               if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
                 // When in laser mode, ignore spindle spin-up delay. Set to turn on laser when cycle starts.
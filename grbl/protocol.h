@@ -46,4 +46,9 @@ void protocol_auto_cycle_start();
 // Block until all buffered steps are executed
 void protocol_buffer_synchronize();
 
+#ifdef ENABLE_WINDOWED_ACKS
+  // Sends the windowed acknowledgement for any executed lines not yet acknowledged.
+  void protocol_flush_ack();
+#endif
+
 #endif
@@ -0,0 +1,204 @@
+/*
+  raster.c - laser raster scanline command
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_RASTER_MODE
+
+#ifdef ENABLE_RASTER_OVERSCAN
+  // Last scanline and its lead-out, so that a scanline continuing it can drop the lead-out.
+  static float overscan_start[N_AXIS]; // Scanline end, where the lead-out starts.
+  static float overscan_end[N_AXIS]; // Lead-out end, where the g-code parser position is left.
+  static float overscan_pixel_vector[N_AXIS];
+  static plan_block_t *overscan_block; // Lead-out block. NULL, if not in the planner buffer.
+#endif
+
+// Converts a hex digit to its value. Returns 0xff, if not a hex digit. Lowercase letters have
+// already been capitalized by the protocol pre-parser.
+static uint8_t raster_hex_value(char c)
+{
+  if ((c >= '0') && (c <= '9')) { return(c-'0'); }
+  if ((c >= 'A') && (c <= 'F')) { return(c-'A'+10); }
+  return(0xff);
+}
+
+
+// Executes a raster scanline as a single G1 line motion from the current position, with the pixel
+// powers written to the raster buffer for the stepper ISR. Feed rate, spindle speed and state, and
+// coolant are taken from the g-code parser state, which is otherwise unchanged except its position.
+//   Format: $R=X<pitch>[Y<pitch>][Z<pitch>]:<pixel hex pairs>
+// NOTE: The pitch words are the signed travel of one pixel in the current units, so the scanline
+// direction and pitch are both set by the pixel travel vector.
+uint8_t raster_execute_line(char *line)
+{
+  if (bit_isfalse(settings.flags,BITFLAG_LASER_MODE)) { return(STATUS_SETTING_DISABLED); }
+
+  // Read the pixel travel vector.
+  uint8_t char_counter = 3; // Start after '$R='
+  float pixel_vector[N_AXIS];
+  clear_vector(pixel_vector);
+  uint8_t axis_words = 0;
+  uint8_t idx;
+  float value;
+  char letter;
+  while ((letter = line[char_counter]) != ':') {
+    if ((letter < 'A') || (letter > 'Z')) { return(STATUS_EXPECTED_COMMAND_LETTER); }
+    char_counter++;
+    if (!read_float(line, &char_counter, &value)) { return(STATUS_BAD_NUMBER_FORMAT); }
+    switch (letter) {
+      case 'X': idx = X_AXIS; break;
+      case 'Y': idx = Y_AXIS; break;
+      case 'Z': idx = Z_AXIS; break;
+      default: return(STATUS_GCODE_UNSUPPORTED_COMMAND);
+    }
+    if (bit_istrue(axis_words,bit(idx))) { return(STATUS_GCODE_WORD_REPEATED); }
+    axis_words |= bit(idx);
+    if (gc_state.modal.units == UNITS_MODE_INCHES) { value *= MM_PER_INCH; }
+    pixel_vector[idx] = value;
+  }
+  char_counter++;
+  if (!axis_words) { return(STATUS_GCODE_NO_AXIS_WORDS); }
+
+  // Check the pixel data. The line buffer always fits in half the raster buffer.
+  char *pixel_data = &line[char_counter];
+  uint8_t pixel_count = 0;
+  while (pixel_data[2*pixel_count] != 0) {
+    if ((raster_hex_value(pixel_data[2*pixel_count]) > 0x0f) ||
+        (raster_hex_value(pixel_data[2*pixel_count+1]) > 0x0f)) { return(STATUS_BAD_NUMBER_FORMAT); }
+    pixel_count++;
+  }
+  if (pixel_count == 0) { return(STATUS_GCODE_VALUE_WORD_MISSING); }
+
+  // Each pixel must span at least one step, or the stepper ISR falls behind the pixel boundaries.
+  float pixel_steps = 0.0;
+  for (idx=0; idx<N_AXIS; idx++) {
+    pixel_steps = max(pixel_steps, fabs(pixel_vector[idx]*settings.steps_per_mm[idx]));
+  }
+  if (pixel_steps < 1.0) { return(STATUS_GCODE_INVALID_TARGET); }
+
+  // Raster scanlines are units per minute feed motions.
+  if ((gc_state.modal.feed_rate == FEED_RATE_MODE_INVERSE_TIME) || (gc_state.feed_rate == 0.0)) {
+    return(STATUS_GCODE_UNDEFINED_FEED_RATE);
+  }
+
+  float start[N_AXIS];
+  memcpy(start, gc_state.position, sizeof(start));
+  #ifdef ENABLE_RASTER_OVERSCAN
+    // A scanline sent from the end of the last lead-out, in the same direction, continues the last
+    // scanline from where its pixels ended.
+    uint8_t is_continued = false;
+    if (!memcmp(gc_state.position, overscan_end, sizeof(overscan_end)) &&
+        !memcmp(pixel_vector, overscan_pixel_vector, sizeof(overscan_pixel_vector))) {
+      memcpy(start, overscan_start, sizeof(start));
+      is_continued = true;
+    }
+  #endif
+  float target[N_AXIS];
+  for (idx=0; idx<N_AXIS; idx++) { target[idx] = start[idx] + pixel_count*pixel_vector[idx]; }
+
+  // Pixels are written after the last committed pixels, so a queued scanline must reach the planner
+  // and commit its pixels first. This also keeps any lead-out the last block in the planner.
+  #ifdef ENABLE_BLOCK_QUEUE
+    mc_queue_synchronize();
+    if (sys.abort) { return(STATUS_OK); } // Bail, if system abort.
+  #endif
+
+  // Wait for room in the raster buffer, like mc_line() does for the planner buffer.
+  while (st_raster_buffer_available() < pixel_count) {
+    protocol_execute_realtime(); // Check for any run-time commands
+    if (sys.abort) { return(STATUS_OK); } // Bail, if system abort.
+    protocol_auto_cycle_start(); // Auto-cycle start, since the buffered scanlines must execute.
+  }
+
+  // Convert each pixel to its spindle PWM value now, so the stepper ISR only has to output it.
+  // NOTE: Spindle speed overrides are applied when the scanline is received, not in realtime.
+  float spindle_speed = sys.spindle_speed; // Restore after computing the PWM values.
+  for (idx=0; idx<pixel_count; idx++) {
+    uint8_t pixel = (raster_hex_value(pixel_data[2*idx]) << 4) | raster_hex_value(pixel_data[2*idx+1]);
+    spindle_pwm_t pwm = SPINDLE_PWM_OFF_VALUE;
+    if ((gc_state.modal.spindle != SPINDLE_DISABLE) && pixel) {
+      pwm = spindle_compute_pwm_value(gc_state.spindle_speed*pixel*(1.0/255.0));
+    }
+    st_raster_buffer_write(idx, pwm);
+  }
+  sys.spindle_speed = spindle_speed;
+
+  plan_line_data_t plan_data;
+  plan_line_data_t *pl_data = &plan_data;
+  memset(pl_data,0,sizeof(plan_line_data_t));
+  pl_data->feed_rate = gc_state.feed_rate;
+  pl_data->spindle_speed = gc_state.spindle_speed;
+  pl_data->condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+  pl_data->raster_pixels = pixel_count;
+  #ifdef ENABLE_RASTER_OVERSCAN
+    // The overscan is the distance to reach the feed rate, or its override, along the scanline.
+    float unit_vec[N_AXIS];
+    memcpy(unit_vec, pixel_vector, sizeof(unit_vec));
+    convert_delta_vector_to_unit_vector(unit_vec);
+    float acceleration = limit_value_by_axis_maximum(settings.acceleration, unit_vec);
+    float feed_rate = gc_state.feed_rate;
+    if (sys.f_override > DEFAULT_FEED_OVERRIDE) { feed_rate *= 0.01*sys.f_override; }
+    feed_rate = min(feed_rate, limit_value_by_axis_maximum(settings.max_rate, unit_vec));
+    float overscan = feed_rate*feed_rate/(2.0*acceleration);
+    #ifdef JERK_LIMITED_PROFILES
+      overscan += 0.5*feed_rate*acceleration/limit_value_by_axis_maximum(settings.jerk, unit_vec);
+    #endif
+
+    // Lead-in and lead-out motions keep the laser off.
+    plan_line_data_t overscan_data;
+    memset(&overscan_data,0,sizeof(plan_line_data_t));
+    overscan_data.feed_rate = gc_state.feed_rate;
+    overscan_data.condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+    float overscan_target[N_AXIS];
+
+    if (is_continued && (overscan_block != NULL) && (plan_get_last_block() == overscan_block)) {
+      // Replace the lead-out of the last scanline, so the scanlines join at full speed. The scanline
+      // is planned right away, without mc_line(), so the stepper never runs out of blocks at speed.
+      if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) { limits_soft_check(target); }
+      if (sys.abort) { return(STATUS_OK); }
+      plan_discard_last_block();
+      plan_buffer_line(target, pl_data);
+    } else {
+      // Rapid to the lead-in start, and accelerate up to the scanline start.
+      for (idx=0; idx<N_AXIS; idx++) { overscan_target[idx] = start[idx] - overscan*unit_vec[idx]; }
+      overscan_data.condition |= PL_COND_FLAG_RAPID_MOTION;
+      mc_line(overscan_target, &overscan_data);
+      overscan_data.condition &= ~PL_COND_FLAG_RAPID_MOTION;
+      mc_line(start, &overscan_data);
+      mc_line(target, pl_data);
+    }
+
+    for (idx=0; idx<N_AXIS; idx++) { overscan_target[idx] = target[idx] + overscan*unit_vec[idx]; }
+    mc_line(overscan_target, &overscan_data);
+    #ifdef ENABLE_BLOCK_QUEUE
+      mc_queue_synchronize();
+    #endif
+    overscan_block = plan_get_last_block();
+    if ((overscan_block != NULL) && overscan_block->raster_pixels) { overscan_block = NULL; } // No lead-out block.
+    memcpy(overscan_start, target, sizeof(target));
+    memcpy(overscan_end, overscan_target, sizeof(overscan_target));
+    memcpy(overscan_pixel_vector, pixel_vector, sizeof(pixel_vector));
+    memcpy(gc_state.position, overscan_target, sizeof(overscan_target));
+  #else
+    mc_line(target, pl_data);
+    memcpy(gc_state.position, target, sizeof(target));
+  #endif
+  return(STATUS_OK);
+}
+
+#endif
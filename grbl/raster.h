@@ -0,0 +1,26 @@
+/*
+  raster.h - laser raster scanline command
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef raster_h
+#define raster_h
+
+// Executes a `$R=` raster scanline command. The axis words set the travel of each pixel from the
+// current position, and the hex pairs after ':' set the power of each pixel as a fraction of S.
+uint8_t raster_execute_line(char *line);
+
+#endif
@@ -33,6 +33,13 @@
 void report_util_setting_prefix(uint8_t n) { serial_write('$'); print_uint8_base10(n); serial_write('='); }
 static void report_util_line_feed() { printPgmString(PSTR("\r\n")); }
 static void report_util_feedback_line_feed() { serial_write(']'); report_util_line_feed(); }
+static void report_util_serial_count(serial_count_t n) {
+  #ifdef SERIAL_LARGE_BUFFERS
+    print_uint32_base10(n);
+  #else
+    print_uint8_base10(n);
+  #endif
+}
 static void report_util_gcode_modes_G() { printPgmString(PSTR(" G")); }
 static void report_util_gcode_modes_M() { printPgmString(PSTR(" M")); }
 // static void report_util_comment_line_feed() { serial_write(')'); report_util_line_feed(); }
@@ -84,6 +91,7 @@ static void report_util_setting_string(uint8_t n) {
         case 1: printPgmString(PSTR(":mm/min")); break;
         case 2: printPgmString(PSTR(":mm/s^2")); break;
         case 3: printPgmString(PSTR(":mm max")); break;
+        case 4: printPgmString(PSTR(":mm/s^3")); break;
       }
       break;
   }
@@ -121,6 +129,37 @@ void report_status_message(uint8_t status_code)
   }
 }
 
+#ifdef ENABLE_BINARY_STREAMING
+  void report_binary_ack(uint8_t count)
+  {
+    printPgmString(PSTR("ok:"));
+    print_uint8_base10(count);
+    report_util_line_feed();
+  }
+#endif
+
+#ifdef ENABLE_LINE_CHECKSUMS
+  void report_line_resend(int32_t line_number)
+  {
+    printPgmString(PSTR("[RS:"));
+    print_uint32_base10(line_number);
+    report_util_feedback_line_feed();
+  }
+#endif
+
+#ifdef ENABLE_WINDOWED_ACKS
+  void report_windowed_ack(uint16_t sequence)
+  {
+    printPgmString(PSTR("ok "));
+    print_uint32_base10(sequence);
+    serial_write(',');
+    print_uint8_base10(plan_get_block_buffer_available());
+    serial_write(',');
+    report_util_serial_count(serial_get_rx_buffer_available());
+    report_util_line_feed();
+  }
+#endif
+
 // Prints alarm messages.
 void report_alarm_message(uint8_t alarm_code)
 {
@@ -193,6 +232,9 @@ void report_grbl_settings() {
   report_util_float_setting(11,settings.junction_deviation,N_DECIMAL_SETTINGVALUE);
   report_util_float_setting(12,settings.arc_tolerance,N_DECIMAL_SETTINGVALUE);
   report_util_uint8_setting(13,bit_istrue(settings.flags,BITFLAG_REPORT_INCHES));
+  #ifdef ENABLE_AUTO_REPORT
+    report_util_float_setting(14,settings.status_report_interval,N_DECIMAL_RPMVALUE);
+  #endif
   report_util_uint8_setting(20,bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE));
   report_util_uint8_setting(21,bit_istrue(settings.flags,BITFLAG_HARD_LIMIT_ENABLE));
   report_util_uint8_setting(22,bit_istrue(settings.flags,BITFLAG_HOMING_ENABLE));
@@ -208,6 +250,19 @@ void report_grbl_settings() {
   #else
     report_util_uint8_setting(32,0);
   #endif
+  #ifdef ENABLE_PWM_FREQUENCY_SETTING
+    report_util_float_setting(33,settings.spindle_pwm_freq,N_DECIMAL_RPMVALUE);
+  #endif
+  #ifdef ENABLE_LASER_PPI
+    report_util_float_setting(34,settings.laser_ppi,N_DECIMAL_SETTINGVALUE);
+    report_util_float_setting(35,settings.laser_pulse_width,N_DECIMAL_SETTINGVALUE);
+  #endif
+  #ifdef ENABLE_LASER_CALIBRATION
+    uint8_t point;
+    for (point=0; point<LASER_CALIBRATION_POINTS; point++) {
+      report_util_float_setting(LASER_CALIBRATION_START_VAL+point,settings.laser_calibration[point],N_DECIMAL_SETTINGVALUE);
+    }
+  #endif
   // Print axis settings
   uint8_t idx, set_idx;
   uint8_t val = AXIS_SETTINGS_START_VAL;
@@ -218,6 +273,9 @@ void report_grbl_settings() {
         case 1: report_util_float_setting(val+idx,settings.max_rate[idx],N_DECIMAL_SETTINGVALUE); break;
         case 2: report_util_float_setting(val+idx,settings.acceleration[idx]/(60*60),N_DECIMAL_SETTINGVALUE); break;
         case 3: report_util_float_setting(val+idx,-settings.max_travel[idx],N_DECIMAL_SETTINGVALUE); break;
+        #ifdef JERK_LIMITED_PROFILES
+          case 4: report_util_float_setting(val+idx,settings.jerk[idx]/(60*60*60),N_DECIMAL_SETTINGVALUE); break;
+        #endif
       }
     }
     val += AXIS_SETTINGS_INCREMENT;
@@ -297,6 +355,17 @@ void report_gcode_modes()
   report_util_gcode_modes_G();
   print_uint8_base10(94-gc_state.modal.feed_rate);
 
+  #ifdef ENABLE_PATH_BLENDING
+    if (gc_state.modal.control == CONTROL_MODE_CONTINUOUS) {
+      report_util_gcode_modes_G();
+      print_uint8_base10(64);
+      if (gc_state.blend_tolerance > 0.0) {
+        printPgmString(PSTR(" P"));
+        printFloat_CoordValue(gc_state.blend_tolerance);
+      }
+    }
+  #endif
+
   if (gc_state.modal.program_flow) {
     report_util_gcode_modes_M();
     switch (gc_state.modal.program_flow) {
@@ -449,19 +518,190 @@ void report_echo_line_received(char *line)
 }
 
 
+#ifdef ENABLE_BINARY_STATUS_REPORT
+  // Converts a rate to a frame value in whole units, saturating at the uint16 limit.
+  static uint16_t report_frame_value(float value)
+  {
+    if (value >= 65535.0) { return(0xFFFF); }
+    return((uint16_t)(value+0.5));
+  }
+
+  // Sends a binary status frame. Values are little-endian, like binary stream frames. The CRC is sent
+  // most significant byte first, so that the CRC over the whole frame is zero when it is intact.
+  static void report_status_frame(uint8_t is_auto)
+  {
+    uint8_t frame[STATUS_FRAME_SIZE];
+    uint8_t *ptr = frame;
+    *ptr++ = STATUS_FRAME_START;
+    *ptr++ = STATUS_FRAME_SIZE;
+    *ptr++ = sys.state;
+    *ptr++ = sys.suspend;
+    int32_t current_position[N_AXIS];
+    st_get_realtime_position(current_position);
+    memcpy(ptr, current_position, sizeof(current_position));
+    ptr += sizeof(current_position);
+    *ptr++ = plan_get_block_buffer_available();
+    serial_count_t rx_available = serial_get_rx_buffer_available();
+    memcpy(ptr, &rx_available, sizeof(serial_count_t));
+    ptr += sizeof(serial_count_t);
+    uint16_t value = report_frame_value(st_get_realtime_rate());
+    memcpy(ptr, &value, sizeof(uint16_t));
+    ptr += sizeof(uint16_t);
+    #ifdef VARIABLE_SPINDLE
+      value = report_frame_value(sys.spindle_speed);
+    #else
+      value = 0;
+    #endif
+    memcpy(ptr, &value, sizeof(uint16_t));
+    ptr += sizeof(uint16_t);
+    *ptr++ = sys.f_override;
+    *ptr++ = sys.r_override;
+    *ptr++ = sys.spindle_speed_ovr;
+
+    #ifdef ENABLE_AUTO_REPORT
+      // Automatic reports are skipped, if the frame is the same as the last one.
+      static uint8_t last_frame[STATUS_FRAME_SIZE-2];
+      if (is_auto && sys.report_last_valid && !memcmp(frame, last_frame, sizeof(last_frame))) { return; }
+      memcpy(last_frame, frame, sizeof(last_frame));
+      sys.report_last_valid = true;
+    #endif
+
+    uint16_t crc = 0;
+    uint8_t idx;
+    for (idx=0; idx<STATUS_FRAME_SIZE-2; idx++) { crc = crc16_update(crc, frame[idx]); }
+    *ptr++ = crc >> 8;
+    *ptr = crc & 0xFF;
+    for (idx=0; idx<STATUS_FRAME_SIZE; idx++) { serial_write(frame[idx]); }
+  }
+#endif
+
+
  // Prints real-time data. This function grabs a real-time snapshot of the stepper subprogram
  // and the actual location of the CNC machine. Users may change the following function to their
  // specific needs, but the desired real-time data report must be as short as possible. This is
  // requires as it minimizes the computational overhead and allows grbl to keep running smoothly,
  // especially during g-code programs with fast, short line segments and high frequency reports (5-20Hz).
-void report_realtime_status()
+#ifdef ENABLE_AUTO_REPORT
+  // Field values of the last status report. Automatic reports compare against them.
+  typedef struct {
+    float position[N_AXIS];
+    float rate;
+    float spindle_speed;
+    int32_t line_number;
+    uint8_t state;
+    uint8_t suspend;
+    uint8_t block_available;
+    serial_count_t rx_available;
+    uint8_t pin_state[3];
+  } report_last_t;
+  static report_last_t report_last;
+
+  // Status report fields that automatic reports omit when unchanged. The state and any other fields
+  // are printed in every report, since their absence has a meaning of its own.
+  #define REPORT_CHANGED_POSITION bit(0)
+  #define REPORT_CHANGED_BUFFER   bit(1)
+  #define REPORT_CHANGED_RATE     bit(2)
+  #define REPORT_CHANGED_OTHER    bit(3)
+  #define REPORT_CHANGED_ALL      0xff
+  #define report_field_changed(field) (changed & (field))
+
+  static void report_status(uint8_t is_auto);
+  void report_realtime_status() { report_status(false); }
+  void report_auto_status() { report_status(true); }
+  static void report_status(uint8_t is_auto)
+#else
+  #define report_field_changed(field) true
+  void report_realtime_status()
+#endif
 {
+  #ifdef ENABLE_BINARY_STATUS_REPORT
+    if (sys.report_binary) {
+      #ifdef ENABLE_AUTO_REPORT
+        report_status_frame(is_auto);
+      #else
+        report_status_frame(false);
+      #endif
+      return;
+    }
+  #endif
+
   uint8_t idx;
   int32_t current_position[N_AXIS]; // Copy current state of the system position variable
-  memcpy(current_position,sys_position,sizeof(sys_position));
+  st_get_realtime_position(current_position);
   float print_position[N_AXIS];
   system_convert_array_steps_to_mpos(print_position,current_position);
 
+  float wco[N_AXIS];
+  if (bit_isfalse(settings.status_report_mask,BITFLAG_RT_STATUS_POSITION_TYPE) ||
+      (sys.report_wco_counter == 0) ) {
+    for (idx=0; idx< N_AXIS; idx++) {
+      // Apply work coordinate offsets and tool length offset to current position.
+      wco[idx] = gc_state.coord_system[idx]+gc_state.coord_offset[idx];
+      if (idx == TOOL_LENGTH_OFFSET_AXIS) { wco[idx] += gc_state.tool_length_offset; }
+      if (bit_isfalse(settings.status_report_mask,BITFLAG_RT_STATUS_POSITION_TYPE)) {
+        print_position[idx] -= wco[idx];
+      }
+    }
+  }
+
+  #ifdef ENABLE_AUTO_REPORT
+    // Compare the fields with the last report of either kind. Automatic reports are skipped, if
+    // nothing has changed. The first report after a reset is always complete.
+    uint8_t changed = 0;
+    if (memcmp(print_position, report_last.position, sizeof(print_position))) {
+      changed |= REPORT_CHANGED_POSITION;
+      memcpy(report_last.position, print_position, sizeof(print_position));
+    }
+    #ifdef REPORT_FIELD_BUFFER_STATE
+      if (bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_BUFFER_STATE)) {
+        uint8_t block_available = plan_get_block_buffer_available();
+        serial_count_t rx_available = serial_get_rx_buffer_available();
+        if ((block_available != report_last.block_available) || (rx_available != report_last.rx_available)) {
+          changed |= REPORT_CHANGED_BUFFER;
+          report_last.block_available = block_available;
+          report_last.rx_available = rx_available;
+        }
+      }
+    #endif
+    #ifdef REPORT_FIELD_CURRENT_FEED_SPEED
+      float rate = st_get_realtime_rate();
+      if (rate != report_last.rate) {
+        changed |= REPORT_CHANGED_RATE;
+        report_last.rate = rate;
+      }
+      #ifdef VARIABLE_SPINDLE
+        if (sys.spindle_speed != report_last.spindle_speed) {
+          changed |= REPORT_CHANGED_RATE;
+          report_last.spindle_speed = sys.spindle_speed;
+        }
+      #endif
+    #endif
+    #if defined(USE_LINE_NUMBERS) && defined(REPORT_FIELD_LINE_NUMBERS)
+      plan_block_t *last_block = plan_get_current_block();
+      int32_t line_number = 0;
+      if (last_block != NULL) { line_number = last_block->line_number; }
+      if (line_number != report_last.line_number) {
+        changed |= REPORT_CHANGED_OTHER;
+        report_last.line_number = line_number;
+      }
+    #endif
+    #ifdef REPORT_FIELD_PIN_STATE
+      uint8_t pin_state[3] = { limits_get_state(), system_control_get_state(), probe_get_state() };
+      if (memcmp(pin_state, report_last.pin_state, sizeof(pin_state))) {
+        changed |= REPORT_CHANGED_OTHER;
+        memcpy(report_last.pin_state, pin_state, sizeof(pin_state));
+      }
+    #endif
+    if ((sys.state != report_last.state) || (sys.suspend != report_last.suspend)) {
+      changed |= REPORT_CHANGED_OTHER;
+      report_last.state = sys.state;
+      report_last.suspend = sys.suspend;
+    }
+    if (!is_auto || !sys.report_last_valid) { changed = REPORT_CHANGED_ALL; }
+    else if (!changed) { return; }
+    sys.report_last_valid = true;
+  #endif
+
   // Report current machine state and sub-states
   serial_write('<');
   switch (sys.state) {
@@ -497,34 +737,24 @@ void report_realtime_status()
     case STATE_SLEEP: printPgmString(PSTR("Sleep")); break;
   }
 
-  float wco[N_AXIS];
-  if (bit_isfalse(settings.status_report_mask,BITFLAG_RT_STATUS_POSITION_TYPE) ||
-      (sys.report_wco_counter == 0) ) {
-    for (idx=0; idx< N_AXIS; idx++) {
-      // Apply work coordinate offsets and tool length offset to current position.
-      wco[idx] = gc_state.coord_system[idx]+gc_state.coord_offset[idx];
-      if (idx == TOOL_LENGTH_OFFSET_AXIS) { wco[idx] += gc_state.tool_length_offset; }
-      if (bit_isfalse(settings.status_report_mask,BITFLAG_RT_STATUS_POSITION_TYPE)) {
-        print_position[idx] -= wco[idx];
-      }
-    }
-  }
-
   // Report machine position
-  if (bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_POSITION_TYPE)) {
-    printPgmString(PSTR("|MPos:"));
-  } else {
-    printPgmString(PSTR("|WPos:"));
+  if (report_field_changed(REPORT_CHANGED_POSITION)) {
+    if (bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_POSITION_TYPE)) {
+      printPgmString(PSTR("|MPos:"));
+    } else {
+      printPgmString(PSTR("|WPos:"));
+    }
+    report_util_axis_values(print_position);
   }
-  report_util_axis_values(print_position);
 
   // Returns planner and serial read buffer states.
   #ifdef REPORT_FIELD_BUFFER_STATE
-    if (bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_BUFFER_STATE)) {
+    if (bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_BUFFER_STATE) &&
+        report_field_changed(REPORT_CHANGED_BUFFER)) {
       printPgmString(PSTR("|Bf:"));
       print_uint8_base10(plan_get_block_buffer_available());
       serial_write(',');
-      print_uint8_base10(serial_get_rx_buffer_available());
+      report_util_serial_count(serial_get_rx_buffer_available());
     }
   #endif
 
@@ -544,15 +774,17 @@ void report_realtime_status()
 
   // Report realtime feed speed
   #ifdef REPORT_FIELD_CURRENT_FEED_SPEED
-    #ifdef VARIABLE_SPINDLE
-      printPgmString(PSTR("|FS:"));
-      printFloat_RateValue(st_get_realtime_rate());
-      serial_write(',');
-      printFloat(sys.spindle_speed,N_DECIMAL_RPMVALUE);
-    #else
-      printPgmString(PSTR("|F:"));
-      printFloat_RateValue(st_get_realtime_rate());
-    #endif      
+    if (report_field_changed(REPORT_CHANGED_RATE)) {
+      #ifdef VARIABLE_SPINDLE
+        printPgmString(PSTR("|FS:"));
+        printFloat_RateValue(st_get_realtime_rate());
+        serial_write(',');
+        printFloat(sys.spindle_speed,N_DECIMAL_RPMVALUE);
+      #else
+        printPgmString(PSTR("|F:"));
+        printFloat_RateValue(st_get_realtime_rate());
+      #endif
+    }
   #endif
 
   #ifdef REPORT_FIELD_PIN_STATE
@@ -38,6 +38,8 @@
 #define STATUS_LINE_LENGTH_EXCEEDED 14
 #define STATUS_TRAVEL_EXCEEDED 15
 #define STATUS_INVALID_JOG_COMMAND 16
+#define STATUS_BINARY_FRAME_ERROR 17
+#define STATUS_LINE_RESEND 18
 
 #define STATUS_GCODE_UNSUPPORTED_COMMAND 20
 #define STATUS_GCODE_MODAL_GROUP_VIOLATION 21
@@ -86,6 +88,28 @@
 // Prints system status messages.
 void report_status_message(uint8_t status_code);
 
+#ifdef ENABLE_BINARY_STREAMING
+  // Acknowledges a batch of executed binary stream frames.
+  void report_binary_ack(uint8_t count);
+#endif
+
+#ifdef ENABLE_LINE_CHECKSUMS
+  // Requests the host to resend all lines from the given line number.
+  void report_line_resend(int32_t line_number);
+#endif
+
+#ifdef ENABLE_WINDOWED_ACKS
+  // Acknowledges all lines up to the given sequence number, with the free planner and serial RX space.
+  void report_windowed_ack(uint16_t sequence);
+#endif
+
+#ifdef ENABLE_BINARY_STATUS_REPORT
+  // Binary status frame start byte and size. Text messages never contain extended ASCII characters,
+  // so the start byte marks a frame in the serial stream. See doc/markdown/interface.md for the layout.
+  #define STATUS_FRAME_START 0xA5
+  #define STATUS_FRAME_SIZE (4*N_AXIS+14+sizeof(serial_count_t))
+#endif
+
 // Prints system alarm messages.
 void report_alarm_message(uint8_t alarm_code);
 
@@ -107,6 +131,11 @@ void report_echo_line_received(char *line);
 // Prints realtime status report
 void report_realtime_status();
 
+#ifdef ENABLE_AUTO_REPORT
+  // Prints an automatic status report with only the fields changed since the last report, if any.
+  void report_auto_status();
+#endif
+
 // Prints recorded probe position
 void report_probe_parameters();
 
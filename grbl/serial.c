@@ -25,38 +25,65 @@
 #define TX_RING_BUFFER (TX_BUFFER_SIZE+1)
 
 uint8_t serial_rx_buffer[RX_RING_BUFFER];
-uint8_t serial_rx_buffer_head = 0;
-volatile uint8_t serial_rx_buffer_tail = 0;
+serial_count_t serial_rx_buffer_head = 0;
+volatile serial_count_t serial_rx_buffer_tail = 0;
 
 uint8_t serial_tx_buffer[TX_RING_BUFFER];
-uint8_t serial_tx_buffer_head = 0;
-volatile uint8_t serial_tx_buffer_tail = 0;
+serial_count_t serial_tx_buffer_head = 0;
+volatile serial_count_t serial_tx_buffer_tail = 0;
+
+
+#ifdef SERIAL_LARGE_BUFFERS
+  // The AVR accesses 16-bit values one byte at a time, so the main program reads and writes the
+  // indices shared with the serial interrupts with interrupts disabled.
+  static serial_count_t serial_get_index(volatile serial_count_t *index)
+  {
+    uint8_t sreg = SREG;
+    cli();
+    serial_count_t value = *index;
+    SREG = sreg;
+    return(value);
+  }
+
+  static void serial_set_index(volatile serial_count_t *index, serial_count_t value)
+  {
+    uint8_t sreg = SREG;
+    cli();
+    *index = value;
+    SREG = sreg;
+  }
+#else
+  #define serial_get_index(index) (*(index))
+  #define serial_set_index(index, value) (*(index) = (value))
+#endif
 
 
 // Returns the number of bytes available in the RX serial buffer.
-uint8_t serial_get_rx_buffer_available()
+serial_count_t serial_get_rx_buffer_available()
 {
-  uint8_t rtail = serial_rx_buffer_tail; // Copy to limit multiple calls to volatile
-  if (serial_rx_buffer_head >= rtail) { return(RX_BUFFER_SIZE - (serial_rx_buffer_head-rtail)); }
-  return((rtail-serial_rx_buffer_head-1));
+  serial_count_t rtail = serial_rx_buffer_tail; // Copy to limit multiple calls to volatile
+  serial_count_t rhead = serial_get_index(&serial_rx_buffer_head);
+  if (rhead >= rtail) { return(RX_BUFFER_SIZE - (rhead-rtail)); }
+  return((rtail-rhead-1));
 }
 
 
 // Returns the number of bytes used in the RX serial buffer.
 // NOTE: Deprecated. Not used unless classic status reports are enabled in config.h.
-uint8_t serial_get_rx_buffer_count()
+serial_count_t serial_get_rx_buffer_count()
 {
-  uint8_t rtail = serial_rx_buffer_tail; // Copy to limit multiple calls to volatile
-  if (serial_rx_buffer_head >= rtail) { return(serial_rx_buffer_head-rtail); }
-  return (RX_BUFFER_SIZE - (rtail-serial_rx_buffer_head));
+  serial_count_t rtail = serial_rx_buffer_tail; // Copy to limit multiple calls to volatile
+  serial_count_t rhead = serial_get_index(&serial_rx_buffer_head);
+  if (rhead >= rtail) { return(rhead-rtail); }
+  return (RX_BUFFER_SIZE - (rtail-rhead));
 }
 
 
 // Returns the number of bytes used in the TX serial buffer.
 // NOTE: Not used except for debugging and ensuring no TX bottlenecks.
-uint8_t serial_get_tx_buffer_count()
+serial_count_t serial_get_tx_buffer_count()
 {
-  uint8_t ttail = serial_tx_buffer_tail; // Copy to limit multiple calls to volatile
+  serial_count_t ttail = serial_get_index(&serial_tx_buffer_tail); // Copy to limit multiple calls to volatile
   if (serial_tx_buffer_head >= ttail) { return(serial_tx_buffer_head-ttail); }
   return (TX_RING_BUFFER - (ttail-serial_tx_buffer_head));
 }
@@ -85,18 +112,18 @@ void serial_init()
 // Writes one byte to the TX serial buffer. Called by main program.
 void serial_write(uint8_t data) {
   // Calculate next head
-  uint8_t next_head = serial_tx_buffer_head + 1;
+  serial_count_t next_head = serial_tx_buffer_head + 1;
   if (next_head == TX_RING_BUFFER) { next_head = 0; }
 
   // Wait until there is space in the buffer
-  while (next_head == serial_tx_buffer_tail) {
+  while (next_head == serial_get_index(&serial_tx_buffer_tail)) {
     // TODO: Restructure st_prep_buffer() calls to be executed here during a long print.
     if (sys_rt_exec_state & EXEC_RESET) { return; } // Only check for abort to avoid an endless loop.
   }
 
   // Store data and advance head
   serial_tx_buffer[serial_tx_buffer_head] = data;
-  serial_tx_buffer_head = next_head;
+  serial_set_index(&serial_tx_buffer_head, next_head);
 
   // Enable Data Register Empty Interrupt to make sure tx-streaming is running
   UCSR0B |=  (1 << UDRIE0);
@@ -106,7 +133,7 @@ void serial_write(uint8_t data) {
 // Data Register Empty Interrupt handler
 ISR(SERIAL_UDRE)
 {
-  uint8_t tail = serial_tx_buffer_tail; // Temporary serial_tx_buffer_tail (to optimize for volatile)
+  serial_count_t tail = serial_tx_buffer_tail; // Temporary serial_tx_buffer_tail (to optimize for volatile)
 
   // Send a byte from the buffer
   UDR0 = serial_tx_buffer[tail];
@@ -125,15 +152,15 @@ ISR(SERIAL_UDRE)
 // Fetches the first byte in the serial read buffer. Called by main program.
 uint8_t serial_read()
 {
-  uint8_t tail = serial_rx_buffer_tail; // Temporary serial_rx_buffer_tail (to optimize for volatile)
-  if (serial_rx_buffer_head == tail) {
+  serial_count_t tail = serial_rx_buffer_tail; // Temporary serial_rx_buffer_tail (to optimize for volatile)
+  if (serial_get_index(&serial_rx_buffer_head) == tail) {
     return SERIAL_NO_DATA;
   } else {
     uint8_t data = serial_rx_buffer[tail];
 
     tail++;
     if (tail == RX_RING_BUFFER) { tail = 0; }
-    serial_rx_buffer_tail = tail;
+    serial_set_index(&serial_rx_buffer_tail, tail);
 
     return data;
   }
@@ -143,7 +170,7 @@ uint8_t serial_read()
 ISR(SERIAL_RX)
 {
   uint8_t data = UDR0;
-  uint8_t next_head;
+  serial_count_t next_head;
 
   // Pick off realtime command characters directly from the serial stream. These characters are
   // not passed into the main buffer, but these set system state flag bits for realtime execution.
@@ -153,7 +180,12 @@ ISR(SERIAL_RX)
     case CMD_CYCLE_START:   system_set_exec_state_flag(EXEC_CYCLE_START); break; // Set as true
     case CMD_FEED_HOLD:     system_set_exec_state_flag(EXEC_FEED_HOLD); break; // Set as true
     default :
-      if (data > 0x7F) { // Real-time control characters are extended ACSII only.
+      #ifdef ENABLE_BINARY_STREAMING
+        // Binary mode request is passed to the buffer to take effect in order with streamed lines.
+        if ((data > 0x7F) && (data != CMD_BINARY_MODE)) {
+      #else
+        if (data > 0x7F) { // Real-time control characters are extended ACSII only.
+      #endif
         switch(data) {
           case CMD_SAFETY_DOOR:   system_set_exec_state_flag(EXEC_SAFETY_DOOR); break; // Set as true
           case CMD_JOG_CANCEL:   
@@ -200,5 +232,5 @@ ISR(SERIAL_RX)
 
 void serial_reset_read_buffer()
 {
-  serial_rx_buffer_tail = serial_rx_buffer_head;
+  serial_set_index(&serial_rx_buffer_tail, serial_get_index(&serial_rx_buffer_head));
 }
@@ -34,6 +34,15 @@
   #endif
 #endif
 
+// Serial buffers over 254 bytes, on targets with the RAM for them, need 16-bit ring buffer indices
+// and byte counts. Otherwise, 8-bit indices keep the serial interrupts as short as possible.
+#if (RX_BUFFER_SIZE > 254) || (TX_BUFFER_SIZE > 254)
+  #define SERIAL_LARGE_BUFFERS
+  typedef uint16_t serial_count_t;
+#else
+  typedef uint8_t serial_count_t;
+#endif
+
 #define SERIAL_NO_DATA 0xff
 
 
@@ -49,14 +58,14 @@ uint8_t serial_read();
 void serial_reset_read_buffer();
 
 // Returns the number of bytes available in the RX serial buffer.
-uint8_t serial_get_rx_buffer_available();
+serial_count_t serial_get_rx_buffer_available();
 
 // Returns the number of bytes used in the RX serial buffer.
 // NOTE: Deprecated. Not used unless classic status reports are enabled in config.h.
-uint8_t serial_get_rx_buffer_count();
+serial_count_t serial_get_rx_buffer_count();
 
 // Returns the number of bytes used in the TX serial buffer.
 // NOTE: Not used except for debugging and ensuring no TX bottlenecks.
-uint8_t serial_get_tx_buffer_count();
+serial_count_t serial_get_tx_buffer_count();
 
 #endif
@@ -72,11 +72,27 @@ void settings_restore(uint8_t restore_flag) {
     settings.step_invert_mask = DEFAULT_STEPPING_INVERT_MASK;
     settings.dir_invert_mask = DEFAULT_DIRECTION_INVERT_MASK;
     settings.status_report_mask = DEFAULT_STATUS_REPORT_MASK;
+    #ifdef ENABLE_AUTO_REPORT
+      settings.status_report_interval = DEFAULT_STATUS_REPORT_INTERVAL;
+    #endif
     settings.junction_deviation = DEFAULT_JUNCTION_DEVIATION;
     settings.arc_tolerance = DEFAULT_ARC_TOLERANCE;
 
     settings.rpm_max = DEFAULT_SPINDLE_RPM_MAX;
     settings.rpm_min = DEFAULT_SPINDLE_RPM_MIN;
+    #ifdef ENABLE_LASER_CALIBRATION
+      uint8_t point;
+      for (point=0; point<LASER_CALIBRATION_POINTS; point++) {
+        settings.laser_calibration[point] = (100.0*point)/(LASER_CALIBRATION_POINTS-1); // Linear
+      }
+    #endif
+    #ifdef ENABLE_PWM_FREQUENCY_SETTING
+      settings.spindle_pwm_freq = DEFAULT_SPINDLE_PWM_FREQUENCY;
+    #endif
+    #ifdef ENABLE_LASER_PPI
+      settings.laser_ppi = DEFAULT_LASER_PPI;
+      settings.laser_pulse_width = DEFAULT_LASER_PULSE_WIDTH;
+    #endif
 
     settings.homing_dir_mask = DEFAULT_HOMING_DIR_MASK;
     settings.homing_feed_rate = DEFAULT_HOMING_FEED_RATE;
@@ -106,6 +122,11 @@ void settings_restore(uint8_t restore_flag) {
     settings.max_travel[X_AXIS] = (-DEFAULT_X_MAX_TRAVEL);
     settings.max_travel[Y_AXIS] = (-DEFAULT_Y_MAX_TRAVEL);
     settings.max_travel[Z_AXIS] = (-DEFAULT_Z_MAX_TRAVEL);
+    #ifdef JERK_LIMITED_PROFILES
+      settings.jerk[X_AXIS] = DEFAULT_X_JERK;
+      settings.jerk[Y_AXIS] = DEFAULT_Y_JERK;
+      settings.jerk[Z_AXIS] = DEFAULT_Z_JERK;
+    #endif
 
     write_global_settings();
   }
@@ -218,6 +239,9 @@ uint8_t settings_store_global_setting(uint8_t parameter, float value) {
             break;
           case 2: settings.acceleration[parameter] = value*60*60; break; // Convert to mm/min^2 for grbl internal use.
           case 3: settings.max_travel[parameter] = -value; break;  // Store as negative for grbl internal use.
+          #ifdef JERK_LIMITED_PROFILES
+            case 4: settings.jerk[parameter] = value*60*60*60; break; // Convert to mm/min^3 for grbl internal use.
+          #endif
         }
         break; // Exit while-loop after setting has been configured and proceed to the EEPROM write call.
       } else {
@@ -264,6 +288,14 @@ uint8_t settings_store_global_setting(uint8_t parameter, float value) {
         else { settings.flags &= ~BITFLAG_REPORT_INCHES; }
         system_flag_wco_change(); // Make sure WCO is immediately updated.
         break;
+      #ifdef ENABLE_AUTO_REPORT
+        case 14:
+          // The watchdog timer counts the interval in up to 255 ticks.
+          if (value > (255*AUTO_REPORT_TICK_MS)) { return(STATUS_INVALID_STATEMENT); }
+          settings.status_report_interval = value;
+          system_auto_report_init(); // Restart automatic report timer
+          break;
+      #endif
       case 20:
         if (int_value) {
           if (bit_isfalse(settings.flags, BITFLAG_HOMING_ENABLE)) { return(STATUS_SOFT_LIMIT_ERROR); }
@@ -297,7 +329,30 @@ uint8_t settings_store_global_setting(uint8_t parameter, float value) {
           return(STATUS_SETTING_DISABLED);
         #endif
         break;
+      #ifdef ENABLE_PWM_FREQUENCY_SETTING
+        case 33:
+          if (value < 1.0) { return(STATUS_INVALID_STATEMENT); }
+          settings.spindle_pwm_freq = value;
+          spindle_init(); // Re-initialize spindle PWM timer
+          break;
+      #endif
+      #ifdef ENABLE_LASER_PPI
+        case 34: settings.laser_ppi = value; break;
+        case 35:
+          if (value <= 0.0) { return(STATUS_INVALID_STATEMENT); }
+          settings.laser_pulse_width = value;
+          spindle_init(); // Re-initialize laser pulse width
+          break;
+      #endif
       default:
+        #ifdef ENABLE_LASER_CALIBRATION
+          if ((parameter >= LASER_CALIBRATION_START_VAL) &&
+              (parameter < LASER_CALIBRATION_START_VAL+LASER_CALIBRATION_POINTS) && (value <= 100.0)) {
+            settings.laser_calibration[parameter-LASER_CALIBRATION_START_VAL] = value;
+            spindle_init(); // Re-initialize spindle rpm calibration
+            break;
+          }
+        #endif
         return(STATUS_INVALID_STATEMENT);
     }
   }
@@ -27,7 +27,42 @@
 
 // Version of the EEPROM data. Will be used to migrate existing data from older versions of Grbl
 // when firmware is upgraded. Always stored in byte 0 of eeprom
-#define SETTINGS_VERSION 10  // NOTE: Check settings_reset() when moving to next version.
+// NOTE: Compile-time options that add settings change the layout of the stored settings. Each one
+// sets its own bit of a layout offset to the version, so that settings stored by a build with other
+// options are restored to defaults, rather than read into shifted fields. Builds without any of
+// these options keep the standard version.
+#ifdef JERK_LIMITED_PROFILES
+  #define SETTINGS_LAYOUT_JERK 1 // $140-$142
+#else
+  #define SETTINGS_LAYOUT_JERK 0
+#endif
+#ifdef ENABLE_AUTO_REPORT
+  #define SETTINGS_LAYOUT_AUTO_REPORT 2 // $14
+#else
+  #define SETTINGS_LAYOUT_AUTO_REPORT 0
+#endif
+#ifdef ENABLE_LASER_CALIBRATION
+  #define SETTINGS_LAYOUT_LASER_CALIBRATION 4 // $40 and up
+#else
+  #define SETTINGS_LAYOUT_LASER_CALIBRATION 0
+#endif
+#ifdef ENABLE_PWM_FREQUENCY_SETTING
+  #define SETTINGS_LAYOUT_PWM_FREQUENCY 8 // $33
+#else
+  #define SETTINGS_LAYOUT_PWM_FREQUENCY 0
+#endif
+#ifdef ENABLE_LASER_PPI
+  #define SETTINGS_LAYOUT_LASER_PPI 16 // $34 and $35
+#else
+  #define SETTINGS_LAYOUT_LASER_PPI 0
+#endif
+#define SETTINGS_LAYOUT (SETTINGS_LAYOUT_JERK | SETTINGS_LAYOUT_AUTO_REPORT | SETTINGS_LAYOUT_LASER_CALIBRATION | \
+                         SETTINGS_LAYOUT_PWM_FREQUENCY | SETTINGS_LAYOUT_LASER_PPI)
+#if SETTINGS_LAYOUT
+  #define SETTINGS_VERSION (100+SETTINGS_LAYOUT) // NOTE: Check settings_reset() when moving to next version.
+#else
+  #define SETTINGS_VERSION 10  // NOTE: Check settings_reset() when moving to next version.
+#endif
 
 // Define bit flag masks for the boolean settings in settings.flag.
 #define BITFLAG_REPORT_INCHES      bit(0)
@@ -70,9 +105,14 @@
 // #define SETTING_INDEX_G92    N_COORDINATE_SYSTEM+2  // Coordinate offset (G92.2,G92.3 not supported)
 
 // Define Grbl axis settings numbering scheme. Starts at START_VAL, every INCREMENT, over N_SETTINGS.
-#define AXIS_N_SETTINGS          4
+#ifdef JERK_LIMITED_PROFILES
+  #define AXIS_N_SETTINGS        5
+#else
+  #define AXIS_N_SETTINGS        4
+#endif
 #define AXIS_SETTINGS_START_VAL  100 // NOTE: Reserving settings values >= 100 for axis settings. Up to 255.
 #define AXIS_SETTINGS_INCREMENT  10  // Must be greater than the number of axis settings
+#define LASER_CALIBRATION_START_VAL 40 // Laser calibration point settings. Up to 99.
 
 // Global persistent settings (Stored from byte EEPROM_ADDR_GLOBAL onwards)
 typedef struct {
@@ -81,6 +121,9 @@ typedef struct {
   float max_rate[N_AXIS];
   float acceleration[N_AXIS];
   float max_travel[N_AXIS];
+  #ifdef JERK_LIMITED_PROFILES
+    float jerk[N_AXIS];
+  #endif
 
   // Remaining Grbl settings
   uint8_t pulse_microseconds;
@@ -88,11 +131,24 @@ typedef struct {
   uint8_t dir_invert_mask;
   uint8_t stepper_idle_lock_time; // If max value 255, steppers do not disable.
   uint8_t status_report_mask; // Mask to indicate desired report data.
+  #ifdef ENABLE_AUTO_REPORT
+    float status_report_interval; // Automatic status report interval (msec). Zero disables.
+  #endif
   float junction_deviation;
   float arc_tolerance;
 
   float rpm_max;
   float rpm_min;
+  #ifdef ENABLE_LASER_CALIBRATION
+    float laser_calibration[LASER_CALIBRATION_POINTS]; // PWM output in percent of range
+  #endif
+  #ifdef ENABLE_PWM_FREQUENCY_SETTING
+    float spindle_pwm_freq; // Spindle PWM frequency (Hz)
+  #endif
+  #ifdef ENABLE_LASER_PPI
+    float laser_ppi; // Laser pulses per inch of path. Zero disables pulsing.
+    float laser_pulse_width; // Laser pulse width (msec)
+  #endif
 
   uint8_t flags;  // Contains default boolean settings
 
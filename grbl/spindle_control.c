@@ -24,6 +24,45 @@
 
 #ifdef VARIABLE_SPINDLE
   static float pwm_gradient; // Precalulated value to speed up rpm to PWM conversions.
+  #ifdef ENABLE_LASER_CALIBRATION
+    static spindle_pwm_t pwm_calibration[LASER_CALIBRATION_POINTS]; // PWM values of the calibration points.
+  #endif
+  #ifdef ENABLE_PWM_DITHERING
+    // PWM register value and the dithered lower bits, scaled to 8 bits, output by the timer overflow ISR.
+    static volatile uint8_t dither_base;
+    static volatile uint8_t dither_fraction;
+    static uint8_t dither_accumulator;
+  #endif
+  #ifdef ENABLE_LASER_PPI
+    static uint8_t pulse_periods; // PWM timer overflows from firing a laser pulse to its end.
+    static volatile uint8_t pulse_periods_remaining;
+  #endif
+  #ifdef LASER_SPINDLE_WITHOUT_SYNC
+    // Laser spindle state to apply once queued motions complete. 
+    static uint8_t deferred_state; // Spindle state and DEFERRED_STATE_PENDING flag
+    static float deferred_rpm;
+    #define DEFERRED_STATE_PENDING bit(7)
+  #endif
+#endif
+
+
+#ifdef ENABLE_PWM_FREQUENCY_SETTING
+  // Returns the PWM timer clock select bits of the prescaler giving the closest frequency, by ratio.
+  static uint8_t spindle_pwm_clock_select(float frequency)
+  {
+    const uint16_t prescaler[] = SPINDLE_PWM_PRESCALERS;
+    uint8_t idx, clock_select = 0;
+    float ratio, min_ratio = SOME_LARGE_VALUE;
+    for (idx=0; idx<(sizeof(prescaler)/sizeof(uint16_t)); idx++) {
+      ratio = (F_CPU/SPINDLE_PWM_PERIOD_COUNTS)/(prescaler[idx]*frequency);
+      if (ratio < 1.0) { ratio = 1.0/ratio; }
+      if (ratio < min_ratio) {
+        min_ratio = ratio;
+        clock_select = idx+1;
+      }
+    }
+    return(clock_select);
+  }
 #endif
 
 
@@ -35,14 +74,42 @@ void spindle_init()
     // combined unless configured otherwise.
     SPINDLE_PWM_DDR |= (1<<SPINDLE_PWM_BIT); // Configure as PWM output pin.
     SPINDLE_TCCRA_REGISTER = SPINDLE_TCCRA_INIT_MASK; // Configure PWM output compare timer
-    SPINDLE_TCCRB_REGISTER = SPINDLE_TCCRB_INIT_MASK;
+    #ifdef ENABLE_PWM_FREQUENCY_SETTING
+      SPINDLE_TCCRB_REGISTER = spindle_pwm_clock_select(settings.spindle_pwm_freq);
+    #else
+      SPINDLE_TCCRB_REGISTER = SPINDLE_TCCRB_INIT_MASK;
+    #endif
     #ifdef USE_SPINDLE_DIR_AS_ENABLE_PIN
       SPINDLE_ENABLE_DDR |= (1<<SPINDLE_ENABLE_BIT); // Configure as output pin.
     #else
       SPINDLE_DIRECTION_DDR |= (1<<SPINDLE_DIRECTION_BIT); // Configure as output pin.
     #endif
 
-    pwm_gradient = SPINDLE_PWM_RANGE/(settings.rpm_max-settings.rpm_min);
+    #ifdef ENABLE_LASER_CALIBRATION
+      // Convert the calibration curve to PWM values. The gradient then converts rpm to curve points.
+      uint8_t point;
+      for (point=0; point<LASER_CALIBRATION_POINTS; point++) {
+        pwm_calibration[point] = lround(settings.laser_calibration[point]*(0.01*((uint16_t)SPINDLE_PWM_RANGE << SPINDLE_PWM_SHIFT)))
+                                 + ((uint16_t)SPINDLE_PWM_MIN_VALUE << SPINDLE_PWM_SHIFT);
+      }
+      pwm_gradient = (LASER_CALIBRATION_POINTS-1)/(settings.rpm_max-settings.rpm_min);
+    #else
+      pwm_gradient = ((uint16_t)SPINDLE_PWM_RANGE << SPINDLE_PWM_SHIFT)/(settings.rpm_max-settings.rpm_min);
+    #endif
+    #ifdef ENABLE_LASER_PPI
+      // Convert the laser pulse width to whole periods of the selected PWM frequency. A pulse starts
+      // at the first timer overflow after it is fired, where the new compare value takes effect, and
+      // that overflow is also its first count. So the count is one more than its periods.
+      const uint16_t prescaler[] = SPINDLE_PWM_PRESCALERS;
+      float periods = settings.laser_pulse_width*((0.001*F_CPU)/SPINDLE_PWM_PERIOD_COUNTS)/
+                      prescaler[(SPINDLE_TCCRB_REGISTER & 0x07)-1];
+      if (periods < 1.0) { periods = 1.0; }
+      else if (periods > 254.0) { periods = 254.0; }
+      pulse_periods = lround(periods)+1;
+    #endif
+    #ifdef LASER_SPINDLE_WITHOUT_SYNC
+      deferred_state = 0;
+    #endif
 
   #else
 
@@ -93,6 +160,12 @@ void spindle_stop()
 {
   #ifdef VARIABLE_SPINDLE
     SPINDLE_TCCRA_REGISTER &= ~(1<<SPINDLE_COMB_BIT); // Disable PWM. Output voltage is zero.
+    #ifdef ENABLE_PWM_DITHERING
+      SPINDLE_TIMSK_REGISTER &= ~(1<<SPINDLE_TOIE_BIT); // Stop dithering.
+    #endif
+    #ifdef ENABLE_LASER_PPI
+      SPINDLE_TIMSK_REGISTER &= ~(1<<SPINDLE_TOIE_BIT); // Cancel any laser pulse.
+    #endif
     #ifdef USE_SPINDLE_DIR_AS_ENABLE_PIN
       #ifdef INVERT_SPINDLE_ENABLE_PIN
         SPINDLE_ENABLE_PORT |= (1<<SPINDLE_ENABLE_BIT);  // Set pin to high
@@ -113,8 +186,19 @@ void spindle_stop()
 #ifdef VARIABLE_SPINDLE
   // Sets spindle speed PWM output and enable pin, if configured. Called by spindle_set_state()
   // and stepper ISR. Keep routine small and efficient.
-  void spindle_set_speed(uint8_t pwm_value)
+  void spindle_set_speed(spindle_pwm_t pwm_value)
   {
+    #ifdef ENABLE_PWM_DITHERING
+      // Output the upper bits. The timer overflow ISR dithers the lower bits, if any.
+      dither_fraction = pwm_value << (8-SPINDLE_PWM_DITHER_BITS);
+      pwm_value >>= SPINDLE_PWM_DITHER_BITS;
+      dither_base = pwm_value;
+      if (dither_fraction) { SPINDLE_TIMSK_REGISTER |= (1<<SPINDLE_TOIE_BIT); }
+      else { SPINDLE_TIMSK_REGISTER &= ~(1<<SPINDLE_TOIE_BIT); }
+    #endif
+    #ifdef ENABLE_LASER_PPI
+      SPINDLE_TIMSK_REGISTER &= ~(1<<SPINDLE_TOIE_BIT); // A new output level cancels any laser pulse.
+    #endif
     SPINDLE_OCR_REGISTER = pwm_value; // Set PWM output level.
     #ifdef SPINDLE_ENABLE_OFF_WITH_ZERO_SPEED
       if (pwm_value == SPINDLE_PWM_OFF_VALUE) {
@@ -138,31 +222,74 @@ void spindle_stop()
 
 
   // Called by spindle_set_state() and step segment generator. Keep routine small and efficient.
-  uint8_t spindle_compute_pwm_value(float rpm) // 328p PWM register is 8-bit.
+  spindle_pwm_t spindle_compute_pwm_value(float rpm) // 328p PWM register is 8-bit.
   {
-    uint8_t pwm_value;
+    spindle_pwm_t pwm_value;
     rpm *= (0.010*sys.spindle_speed_ovr); // Scale by spindle speed override value.
     // Calculate PWM register value based on rpm max/min settings and programmed rpm.
     if ((settings.rpm_min >= settings.rpm_max) || (rpm >= settings.rpm_max)) {
       // No PWM range possible. Set simple on/off spindle control pin state.
       sys.spindle_speed = settings.rpm_max;
-      pwm_value = SPINDLE_PWM_MAX_VALUE;
+      pwm_value = ((uint16_t)SPINDLE_PWM_MAX_VALUE << SPINDLE_PWM_SHIFT);
     } else if (rpm <= settings.rpm_min) {
       if (rpm == 0.0) { // S0 disables spindle
         sys.spindle_speed = 0.0;
         pwm_value = SPINDLE_PWM_OFF_VALUE;
       } else { // Set minimum PWM output
         sys.spindle_speed = settings.rpm_min;
-        pwm_value = SPINDLE_PWM_MIN_VALUE;
+        pwm_value = ((uint16_t)SPINDLE_PWM_MIN_VALUE << SPINDLE_PWM_SHIFT);
       }
     } else { 
-      // Compute intermediate PWM value with linear spindle speed model.
-      // NOTE: A nonlinear model could be installed here, if required, but keep it VERY light-weight.
       sys.spindle_speed = rpm;
-      pwm_value = floor((rpm-settings.rpm_min)*pwm_gradient) + SPINDLE_PWM_MIN_VALUE;
+      #ifdef ENABLE_LASER_CALIBRATION
+        // Compute intermediate PWM value by interpolating between the two nearest calibration points.
+        float point = (rpm-settings.rpm_min)*pwm_gradient;
+        uint8_t idx = trunc(point);
+        if (idx > LASER_CALIBRATION_POINTS-2) { idx = LASER_CALIBRATION_POINTS-2; } // Float round-off
+        pwm_value = pwm_calibration[idx] + floor((point-idx)*((int16_t)pwm_calibration[idx+1]-(int16_t)pwm_calibration[idx]));
+      #else
+        // Compute intermediate PWM value with linear spindle speed model.
+        // NOTE: A nonlinear model could be installed here, if required, but keep it VERY light-weight.
+        pwm_value = floor((rpm-settings.rpm_min)*pwm_gradient) + ((uint16_t)SPINDLE_PWM_MIN_VALUE << SPINDLE_PWM_SHIFT);
+      #endif
     }
     return(pwm_value);
   }
+
+
+  #ifdef ENABLE_PWM_DITHERING
+    // Timer overflow ISR at the end of each PWM period. Adds the dithered lower bits to an 8-bit
+    // accumulator and outputs the carry in the next period. The output compare register is double
+    // buffered and updates at the start of the next period.
+    ISR(SPINDLE_OVF_vect)
+    {
+      uint8_t accumulator = dither_accumulator + dither_fraction;
+      if (accumulator < dither_accumulator) { SPINDLE_OCR_REGISTER = dither_base+1; } // Carry
+      else { SPINDLE_OCR_REGISTER = dither_base; }
+      dither_accumulator = accumulator;
+    }
+  #endif
+
+
+  #ifdef ENABLE_LASER_PPI
+    // Fires a laser pulse. Called by the stepper ISR at each pulse spacing. A pulse fired before the
+    // last one ends extends it.
+    void spindle_fire_pulse(spindle_pwm_t pwm_value)
+    {
+      spindle_set_speed(pwm_value);
+      pulse_periods_remaining = pulse_periods;
+      SPINDLE_TIFR_REGISTER = (1<<SPINDLE_TOV_BIT); // Clear the stale overflow. The timer never stops.
+      SPINDLE_TIMSK_REGISTER |= (1<<SPINDLE_TOIE_BIT);
+    }
+
+
+    // Timer overflow ISR at the end of each PWM period. Counts down the laser pulse and turns off the
+    // laser when it ends.
+    ISR(SPINDLE_OVF_vect)
+    {
+      if (--pulse_periods_remaining == 0) { spindle_set_speed(SPINDLE_PWM_OFF_VALUE); }
+    }
+  #endif
 #endif
 
 
@@ -223,9 +350,39 @@ void spindle_stop()
   void spindle_sync(uint8_t state, float rpm)
   {
     if (sys.state == STATE_CHECK_MODE) { return; }
+    #ifdef LASER_SPINDLE_WITHOUT_SYNC
+      // Laser motions carry their own spindle state. While moving, only the state once stopped changes.
+      if (bit_istrue(settings.flags,BITFLAG_LASER_MODE) && (plan_get_current_block() || (sys.state & STATE_CYCLE))) {
+        deferred_state = state | DEFERRED_STATE_PENDING;
+        deferred_rpm = rpm;
+        #if defined(USE_SPINDLE_DIR_AS_ENABLE_PIN) && !defined(SPINDLE_ENABLE_OFF_WITH_ZERO_SPEED)
+          // The stepper only sets the PWM output, so turn on the enable pin now for the queued motions
+          // that fire the laser. A deferred M5 turns it off again once stopped.
+          if (state != SPINDLE_DISABLE) {
+            #ifdef INVERT_SPINDLE_ENABLE_PIN
+              SPINDLE_ENABLE_PORT &= ~(1<<SPINDLE_ENABLE_BIT);
+            #else
+              SPINDLE_ENABLE_PORT |= (1<<SPINDLE_ENABLE_BIT);
+            #endif
+          }
+        #endif
+        return;
+      }
+    #endif
     protocol_buffer_synchronize(); // Empty planner buffer to ensure spindle is set when programmed.
     spindle_set_state(state,rpm);
   }
+
+
+  #ifdef LASER_SPINDLE_WITHOUT_SYNC
+    void spindle_sync_deferred()
+    {
+      if (deferred_state & DEFERRED_STATE_PENDING) {
+        deferred_state &= ~DEFERRED_STATE_PENDING;
+        spindle_set_state(deferred_state,deferred_rpm);
+      }
+    }
+  #endif
 #else
   void _spindle_sync(uint8_t state)
   {
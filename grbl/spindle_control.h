@@ -29,6 +29,18 @@
 #define SPINDLE_STATE_CW       bit(0)
 #define SPINDLE_STATE_CCW      bit(1)
 
+#ifdef VARIABLE_SPINDLE
+  // Spindle PWM values. With PWM dithering, the values have SPINDLE_PWM_SHIFT bits below the 8-bit
+  // PWM register value.
+  #ifdef ENABLE_PWM_DITHERING
+    #define SPINDLE_PWM_SHIFT SPINDLE_PWM_DITHER_BITS
+    typedef uint16_t spindle_pwm_t;
+  #else
+    #define SPINDLE_PWM_SHIFT 0
+    typedef uint8_t spindle_pwm_t;
+  #endif
+#endif
+
 
 // Initializes spindle pins and hardware PWM, if enabled.
 void spindle_init();
@@ -44,15 +56,25 @@ uint8_t spindle_get_state();
   // Called by g-code parser when setting spindle state and requires a buffer sync.
   void spindle_sync(uint8_t state, float rpm);
 
+  #ifdef LASER_SPINDLE_WITHOUT_SYNC
+    // Applies a laser spindle state deferred by spindle_sync(). Called when all motions have completed.
+    void spindle_sync_deferred();
+  #endif
+
   // Sets spindle running state with direction, enable, and spindle PWM.
   void spindle_set_state(uint8_t state, float rpm); 
   
   // Sets spindle PWM quickly for stepper ISR. Also called by spindle_set_state().
-  // NOTE: 328p PWM register is 8-bit.
-  void spindle_set_speed(uint8_t pwm_value);
+  // NOTE: 328p PWM register is 8-bit. Any lower bits are dithered.
+  void spindle_set_speed(spindle_pwm_t pwm_value);
   
   // Computes 328p-specific PWM register value for the given RPM for quick updating.
-  uint8_t spindle_compute_pwm_value(float rpm);
+  spindle_pwm_t spindle_compute_pwm_value(float rpm);
+
+  #ifdef ENABLE_LASER_PPI
+    // Fires a laser pulse of the $35 pulse width at the given PWM value. Called by the stepper ISR.
+    void spindle_fire_pulse(spindle_pwm_t pwm_value);
+  #endif
   
 #else
   
@@ -29,6 +29,24 @@
 #define RAMP_CRUISE 1
 #define RAMP_DECEL 2
 #define RAMP_DECEL_OVERRIDE 3
+#ifdef JERK_LIMITED_PROFILES
+  #define RAMP_MIN_SPEED_GAIN 1.01 // Skips S-curve accelerations of less than 1% of the current speed.
+  #define RAMP_ENVELOPE_TOLERANCE 0.9999 // Absorbs planner round-off in junction limit comparisons.
+#endif
+
+#ifdef FIXED_POINT_SEGMENTS
+  // Fixed-point scaling of the segment generator. Distances are in 1/256 steps, speeds in 1/65536
+  // steps per segment, and accelerations in 1/65536 steps per segment^2. Segment times are in CPU cycles.
+  #define FIXED_DIST_SHIFT 8
+  #define FIXED_SPEED_SHIFT 16
+  #define CYCLES_PER_SEGMENT (F_CPU/ACCELERATION_TICKS_PER_SECOND)
+#endif
+
+#ifdef ENABLE_LASER_PPI
+  // Fixed-point laser pulse spacing of the stepper ISR pulse distance counter. At most one pulse
+  // fires per step event.
+  #define PPI_PULSE_SPACING 0x1000000UL
+#endif
 
 #define PREP_FLAG_RECALCULATE bit(0)
 #define PREP_FLAG_HOLD_PARTIAL_BLOCK bit(1)
@@ -70,6 +88,16 @@ typedef struct {
   #ifdef VARIABLE_SPINDLE
     uint8_t is_pwm_rate_adjusted; // Tracks motions that require constant laser power/rate
   #endif
+  #ifdef ENABLE_RASTER_MODE
+    uint32_t raster_steps;  // Raster scanline pixels, scaled like the axis steps. Zero if not a raster.
+    uint8_t raster_index;   // Raster buffer index of the first scanline pixel.
+  #endif
+  #ifdef ENABLE_LASER_PPI
+    uint32_t ppi_increment; // Laser pulse distance per step event, in PPI_PULSE_SPACING per pulse. Zero if not pulsed.
+  #endif
+  #ifdef COOLANT_WITHOUT_SYNC
+    uint8_t coolant_condition; // Planner coolant and system motion condition flags.
+  #endif
 } st_block_t;
 static st_block_t st_block_buffer[SEGMENT_BUFFER_SIZE-1];
 
@@ -87,7 +115,7 @@ typedef struct {
     uint8_t prescaler;      // Without AMASS, a prescaler is required to adjust for slow timing.
   #endif
   #ifdef VARIABLE_SPINDLE
-    uint8_t spindle_pwm;
+    spindle_pwm_t spindle_pwm;
   #endif
 } segment_t;
 static segment_t segment_buffer[SEGMENT_BUFFER_SIZE];
@@ -98,6 +126,14 @@ typedef struct {
   uint32_t counter_x,        // Counter variables for the bresenham line tracer
            counter_y,
            counter_z;
+  #ifdef ENABLE_RASTER_MODE
+    uint32_t counter_raster;  // Bresenham counter of the raster pixel boundaries
+    uint8_t raster_index;     // Raster buffer index of the pixel being executed
+  #endif
+  #ifdef ENABLE_LASER_PPI
+    uint32_t counter_ppi;     // Laser pulse distance counter. Carries over between pulsed blocks.
+    uint8_t ppi_pulsing;      // True while executing a pulsed block.
+  #endif
   #ifdef STEP_PULSE_DELAY
     uint8_t step_bits;  // Stores out_bits output to complete the step pulse delay
   #endif
@@ -108,10 +144,20 @@ typedef struct {
   uint8_t dir_outbits;
   #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
     uint32_t steps[N_AXIS];
+    #ifdef ENABLE_RASTER_MODE
+      uint32_t raster_steps;
+    #endif
+    #ifdef ENABLE_LASER_PPI
+      uint32_t ppi_increment;
+    #endif
   #endif
 
   uint16_t step_count;       // Steps remaining in line segment motion
+  uint16_t segment_steps[N_AXIS]; // Steps executed per axis by the current segment. Not yet in sys_position.
   uint8_t exec_block_index; // Tracks the current st_block index. Change indicates new block.
+  #ifdef COOLANT_WITHOUT_SYNC
+    uint8_t coolant_condition; // Coolant condition of the last executed block.
+  #endif
   st_block_t *exec_block;   // Pointer to the block data for the segment being executed
   segment_t *exec_segment;  // Pointer to the segment being executed
 } stepper_t;
@@ -122,6 +168,14 @@ static volatile uint8_t segment_buffer_tail;
 static uint8_t segment_buffer_head;
 static uint8_t segment_next_head;
 
+#ifdef ENABLE_RASTER_MODE
+  // Raster pixel ring buffer. Holds the spindle PWM values of the pixels of queued raster scanlines,
+  // which the stepper ISR outputs at each pixel boundary.
+  static spindle_pwm_t raster_buffer[RASTER_BUFFER_SIZE];
+  static uint8_t raster_buffer_head; // Index after the last pixel of a planned raster block.
+  static volatile uint8_t raster_buffer_tail; // Index of the pixel being executed, or the next one.
+#endif
+
 // Step and direction port invert masks.
 static uint8_t step_port_invert_mask;
 static uint8_t dir_port_invert_mask;
@@ -140,16 +194,26 @@ typedef struct {
   uint8_t st_block_index;  // Index of stepper common data block being prepped
   uint8_t recalculate_flag;
 
-  float dt_remainder;
-  float steps_remaining;
+  #ifdef FIXED_POINT_SEGMENTS
+    uint32_t dt_remainder;    // Partial step time carried to the next segment (cycles)
+    uint32_t steps_remaining; // Whole steps remaining in the block, rounded up
+  #else
+    float dt_remainder;
+    float steps_remaining;
+  #endif
   float step_per_mm;
   float req_mm_increment;
 
   #ifdef PARKING_ENABLE
     uint8_t last_st_block_index;
-    float last_steps_remaining;
+    #ifdef FIXED_POINT_SEGMENTS
+      uint32_t last_steps_remaining;
+      uint32_t last_dt_remainder;
+    #else
+      float last_steps_remaining;
+      float last_dt_remainder;
+    #endif
     float last_step_per_mm;
-    float last_dt_remainder;
   #endif
 
   uint8_t ramp_type;      // Current segment ramp state
@@ -161,13 +225,71 @@ typedef struct {
   float accelerate_until; // Acceleration ramp end measured from end of block (mm)
   float decelerate_after; // Deceleration ramp start measured from end of block (mm)
 
+  #ifdef JERK_LIMITED_PROFILES
+    uint8_t ramp_hold;      // Flags a feed hold S-curve deceleration in progress. May span blocks.
+    float acceleration;     // Acceleration limit of the planned S-curve ramps (mm/min^2)
+    float jerk;             // Jerk limit of the planned S-curve ramps (mm/min^3)
+    float ramp_start_speed; // Speed at the start of the active S-curve ramp (mm/min)
+    float ramp_delta_speed; // Signed speed change over the active S-curve ramp (mm/min)
+    float ramp_jerk;        // Signed jerk of the active S-curve ramp (mm/min^3)
+    float ramp_jerk_time;   // Duration of each of the ramp's jerk-in and jerk-out phases (min)
+    float ramp_time;        // Total duration of the active S-curve ramp (min)
+    float ramp_elapsed;     // Ramp time executed at the end of the segment buffer (min)
+    float ramp_origin;      // Ramp start position measured from end of block (mm)
+  #endif
+
+  #ifdef FIXED_POINT_SEGMENTS
+    // Velocity profile of the prepped block in fixed-point. Distances are measured from end of block.
+    float dist_per_mm;          // Scale from mm to fixed-point distance
+    float mm_per_dist;
+    float speed_per_mm_min;     // Scale from mm/min to fixed-point speed
+    float mm_min_per_speed;
+    int32_t dist_remaining;     // Distance remaining at the end of the segment buffer
+    uint16_t dist_fraction;     // Fraction of a distance unit traveled, but not yet subtracted
+    int32_t dist_accelerate_until;
+    int32_t dist_decelerate_after;
+    int32_t dist_complete;
+    int32_t dist_minimum;       // Minimum distance of a segment. Guarantees at least one step.
+    int32_t speed;              // Current speed at the end of the segment buffer
+    int32_t acceleration;
+  #endif
+
+  #ifdef ENABLE_NATIVE_ARCS
+    uint8_t arc_chord_queued;   // Flags the prepped stepper block data as in use by a queued arc chord.
+    float arc_millimeters;      // Total arc length of the arc block being prepped (mm)
+    float arc_segment_time;     // Maximum segment time keeping arc chords within the arc tolerance (min)
+    int32_t arc_steps[N_AXIS];  // End of the last arc chord relative to the arc block start (steps)
+  #endif
+
   #ifdef VARIABLE_SPINDLE
     float inv_rate;    // Used by PWM laser mode to speed up segment calculations.
-    uint8_t current_spindle_pwm; 
+    spindle_pwm_t current_spindle_pwm; 
+    #ifdef LASER_PWM_STEP_RATE
+      float programmed_cycles; // CPU cycles per step at the programmed rate. Used by PWM laser mode.
+    #endif
+  #endif
+
+  #ifdef ENABLE_RASTER_MODE
+    uint8_t raster_index;  // Raster buffer index of the first pixel of the next raster block.
+  #endif
+
+  #ifdef ENABLE_LASER_PPI
+    float ppi_pulses_per_mm;  // Laser pulses per mm of the block being prepped. Zero if not pulsed.
   #endif
 } st_prep_t;
 static st_prep_t prep;
 
+#ifdef JERK_LIMITED_PROFILES
+  // Junction speed limits ahead of the S-curve velocity profile, collected by its look-ahead.
+  typedef struct {
+    float speed;     // Junction speed limit (mm/min)
+    float mm;        // Distance ahead of the profile (mm)
+    uint8_t binding; // False if enforced by a lower limit further ahead.
+  } st_junction_t;
+  static st_junction_t st_junction[BLOCK_BUFFER_SIZE];
+  static uint8_t st_junction_count;
+#endif
+
 
 /*    BLOCK VELOCITY PROFILE DEFINITION
           __________________________
@@ -257,6 +379,41 @@ void st_go_idle()
 }
 
 
+// Adds the steps executed by the current segment to a position vector in steps, in the direction
+// of the executing block.
+static void st_add_segment_steps(int32_t *position)
+{
+  uint8_t direction_bits = st.exec_block->direction_bits;
+  if (direction_bits & (1<<X_DIRECTION_BIT)) { position[X_AXIS] -= st.segment_steps[X_AXIS]; }
+  else { position[X_AXIS] += st.segment_steps[X_AXIS]; }
+  if (direction_bits & (1<<Y_DIRECTION_BIT)) { position[Y_AXIS] -= st.segment_steps[Y_AXIS]; }
+  else { position[Y_AXIS] += st.segment_steps[Y_AXIS]; }
+  if (direction_bits & (1<<Z_DIRECTION_BIT)) { position[Z_AXIS] -= st.segment_steps[Z_AXIS]; }
+  else { position[Z_AXIS] += st.segment_steps[Z_AXIS]; }
+}
+
+
+// Applies the steps executed by the current segment to sys_position. Called by the stepper ISR
+// when a segment completes, and by st_reset() for a segment stopped part way.
+static void st_update_position()
+{
+  st_add_segment_steps(sys_position);
+  memset(st.segment_steps,0,sizeof(st.segment_steps));
+}
+
+
+// Returns the real-time machine position in steps, including the steps of the executing segment.
+// Interrupts are disabled during the copy, so the position is coherent from any context.
+void st_get_realtime_position(int32_t *position)
+{
+  uint8_t sreg = SREG;
+  cli();
+  memcpy(position,sys_position,sizeof(sys_position));
+  if (st.exec_block != NULL) { st_add_segment_steps(position); }
+  SREG = sreg;
+}
+
+
 /* "The Stepper Driver Interrupt" - This timer interrupt is the workhorse of Grbl. Grbl employs
    the venerable Bresenham line algorithm to manage and exactly synchronize multi-axis moves.
    Unlike the popular DDA algorithm, the Bresenham algorithm is not susceptible to numerical
@@ -302,9 +459,9 @@ void st_go_idle()
    ISR is 5usec typical and 25usec maximum, well below requirement.
    NOTE: This ISR expects at least one step to be executed per segment.
 */
-// TODO: Replace direct updating of the int32 position counters in the ISR somehow. Perhaps use smaller
-// int8 variables and update position counters only when a segment completes. This can get complicated
-// with probing and homing cycles that require true real-time positions.
+// NOTE: The ISR only counts the steps of the executing segment per axis, and applies them to the
+// int32 sys_position counters when the segment completes. Real-time positions must be read with
+// st_get_realtime_position(), which adds the steps of the executing segment.
 ISR(TIMER1_COMPA_vect)
 {
   if (busy) { return; } // The busy-flag is used to avoid reentering this interrupt
@@ -351,6 +508,31 @@ ISR(TIMER1_COMPA_vect)
 
         // Initialize Bresenham line and distance counters
         st.counter_x = st.counter_y = st.counter_z = (st.exec_block->step_event_count >> 1);
+        #ifdef ENABLE_RASTER_MODE
+          // Pixel boundaries are not centered like steps. The first pixel spans its full length.
+          if (st.exec_block->raster_steps) {
+            st.counter_raster = 0;
+            st.raster_index = st.exec_block->raster_index;
+            raster_buffer_tail = st.raster_index; // Frees the pixels of the last raster block.
+          }
+        #endif
+        #ifdef ENABLE_LASER_PPI
+          // Pulse spacing carries over between consecutive pulsed blocks. Otherwise, the laser is off
+          // until the first pulse fires at the first step event.
+          if (st.exec_block->ppi_increment && !st.ppi_pulsing) {
+            st.counter_ppi = PPI_PULSE_SPACING;
+            spindle_set_speed(SPINDLE_PWM_OFF_VALUE);
+          }
+          st.ppi_pulsing = (st.exec_block->ppi_increment != 0);
+        #endif
+        #ifdef COOLANT_WITHOUT_SYNC
+          // Set programmed coolant changes as the block starts. System motions keep the coolant as is.
+          if (bit_isfalse(st.exec_block->coolant_condition,PL_COND_FLAG_SYSTEM_MOTION) &&
+              (st.exec_block->coolant_condition != st.coolant_condition)) {
+            st.coolant_condition = st.exec_block->coolant_condition;
+            coolant_set_state(st.coolant_condition);
+          }
+        #endif
       }
       st.dir_outbits = st.exec_block->direction_bits ^ dir_port_invert_mask;
 
@@ -359,11 +541,29 @@ ISR(TIMER1_COMPA_vect)
         st.steps[X_AXIS] = st.exec_block->steps[X_AXIS] >> st.exec_segment->amass_level;
         st.steps[Y_AXIS] = st.exec_block->steps[Y_AXIS] >> st.exec_segment->amass_level;
         st.steps[Z_AXIS] = st.exec_block->steps[Z_AXIS] >> st.exec_segment->amass_level;
+        #ifdef ENABLE_RASTER_MODE
+          st.raster_steps = st.exec_block->raster_steps >> st.exec_segment->amass_level;
+        #endif
+        #ifdef ENABLE_LASER_PPI
+          st.ppi_increment = st.exec_block->ppi_increment >> st.exec_segment->amass_level;
+        #endif
       #endif
 
       #ifdef VARIABLE_SPINDLE
         // Set real-time spindle output as segment is loaded, just prior to the first step.
-        spindle_set_speed(st.exec_segment->spindle_pwm);
+        #ifdef ENABLE_LASER_PPI
+          // Pulsed blocks leave the output to the laser pulses.
+          if (!st.exec_block->ppi_increment)
+        #endif
+        {
+          #ifdef ENABLE_RASTER_MODE
+            // Raster scanlines output the power of the pixel being executed instead.
+            if (st.exec_block->raster_steps) { spindle_set_speed(raster_buffer[st.raster_index]); }
+            else { spindle_set_speed(st.exec_segment->spindle_pwm); }
+          #else
+            spindle_set_speed(st.exec_segment->spindle_pwm);
+          #endif
+        }
       #endif
 
     } else {
@@ -371,7 +571,11 @@ ISR(TIMER1_COMPA_vect)
       st_go_idle();
       #ifdef VARIABLE_SPINDLE
         // Ensure pwm is set properly upon completion of rate-controlled motion.
-        if (st.exec_block->is_pwm_rate_adjusted) { spindle_set_speed(SPINDLE_PWM_OFF_VALUE); }
+        #ifdef ENABLE_RASTER_MODE
+          if (st.exec_block->is_pwm_rate_adjusted || st.exec_block->raster_steps) { spindle_set_speed(SPINDLE_PWM_OFF_VALUE); }
+        #else
+          if (st.exec_block->is_pwm_rate_adjusted) { spindle_set_speed(SPINDLE_PWM_OFF_VALUE); }
+        #endif
       #endif
       system_set_exec_state_flag(EXEC_CYCLE_STOP); // Flag main program for cycle end
       return; // Nothing to do but exit.
@@ -394,8 +598,7 @@ ISR(TIMER1_COMPA_vect)
   if (st.counter_x > st.exec_block->step_event_count) {
     st.step_outbits |= (1<<X_STEP_BIT);
     st.counter_x -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<X_DIRECTION_BIT)) { sys_position[X_AXIS]--; }
-    else { sys_position[X_AXIS]++; }
+    st.segment_steps[X_AXIS]++;
   }
   #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
     st.counter_y += st.steps[Y_AXIS];
@@ -405,8 +608,7 @@ ISR(TIMER1_COMPA_vect)
   if (st.counter_y > st.exec_block->step_event_count) {
     st.step_outbits |= (1<<Y_STEP_BIT);
     st.counter_y -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<Y_DIRECTION_BIT)) { sys_position[Y_AXIS]--; }
-    else { sys_position[Y_AXIS]++; }
+    st.segment_steps[Y_AXIS]++;
   }
   #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
     st.counter_z += st.steps[Z_AXIS];
@@ -416,16 +618,48 @@ ISR(TIMER1_COMPA_vect)
   if (st.counter_z > st.exec_block->step_event_count) {
     st.step_outbits |= (1<<Z_STEP_BIT);
     st.counter_z -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<Z_DIRECTION_BIT)) { sys_position[Z_AXIS]--; }
-    else { sys_position[Z_AXIS]++; }
+    st.segment_steps[Z_AXIS]++;
   }
 
+  #ifdef ENABLE_RASTER_MODE
+    // Trace raster pixel boundaries like another axis and output the next pixel power at each one.
+    if (st.exec_block->raster_steps) {
+      #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        st.counter_raster += st.raster_steps;
+      #else
+        st.counter_raster += st.exec_block->raster_steps;
+      #endif
+      if (st.counter_raster > st.exec_block->step_event_count) {
+        st.counter_raster -= st.exec_block->step_event_count;
+        if (++st.raster_index == RASTER_BUFFER_SIZE) { st.raster_index = 0; }
+        raster_buffer_tail = st.raster_index;
+        spindle_set_speed(raster_buffer[st.raster_index]);
+      }
+    }
+  #endif
+
+  #ifdef ENABLE_LASER_PPI
+    // Trace the path distance like another axis and fire a laser pulse at each pulse spacing.
+    if (st.exec_block->ppi_increment) {
+      #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        st.counter_ppi += st.ppi_increment;
+      #else
+        st.counter_ppi += st.exec_block->ppi_increment;
+      #endif
+      if (st.counter_ppi >= PPI_PULSE_SPACING) {
+        st.counter_ppi -= PPI_PULSE_SPACING;
+        spindle_fire_pulse(st.exec_segment->spindle_pwm);
+      }
+    }
+  #endif
+
   // During a homing cycle, lock out and prevent desired axes from moving.
   if (sys.state == STATE_HOMING) { st.step_outbits &= sys.homing_axis_lock; }
 
   st.step_count--; // Decrement step events count
   if (st.step_count == 0) {
-    // Segment is complete. Discard current segment and advance segment indexing.
+    // Segment is complete. Update the machine position, discard current segment and advance segment indexing.
+    st_update_position();
     st.exec_segment = NULL;
     if ( ++segment_buffer_tail == SEGMENT_BUFFER_SIZE) { segment_buffer_tail = 0; }
   }
@@ -484,6 +718,9 @@ void st_reset()
   // Initialize stepper driver idle state.
   st_go_idle();
 
+  // Keep the steps of a segment stopped part way, before clearing the stepper variables.
+  if (st.exec_block != NULL) { st_update_position(); }
+
   // Initialize stepper algorithm variables.
   memset(&prep, 0, sizeof(st_prep_t));
   memset(&st, 0, sizeof(stepper_t));
@@ -493,6 +730,10 @@ void st_reset()
   segment_buffer_head = 0; // empty = tail
   segment_next_head = 1;
   busy = false;
+  #ifdef ENABLE_RASTER_MODE
+    raster_buffer_tail = 0;
+    raster_buffer_head = 0;
+  #endif
 
   st_generate_step_dir_invert_masks();
   st.dir_outbits = dir_port_invert_mask; // Initialize direction bits to default.
@@ -550,6 +791,334 @@ static uint8_t st_next_block_index(uint8_t block_index)
 }
 
 
+#ifdef JERK_LIMITED_PROFILES
+  /* S-CURVE VELOCITY PROFILES
+     With jerk limiting, the speed only changes in S-curve ramps, which always start and end at zero
+     acceleration, and otherwise cruises. Within a ramp, the acceleration rises at the jerk limit until
+     it reaches the acceleration limit, holds, and then falls back to zero at the jerk limit. Short
+     ramps never reach full acceleration and consist only of the jerk-in and jerk-out phases. The
+     velocity curve is point-symmetric about the middle of the ramp, so a ramp travels the average of
+     its start and end speeds over its duration. Ramps are computed in time from their start, rather
+     than by accumulating segment distances, to avoid round-off.
+       A ramp is not confined to a single planner block. The planner still plans the block entry
+     speeds with constant acceleration, and these, along with the block nominal speeds, become the
+     speed limits at each block junction. Whenever a ramp completes or a new block is loaded, the
+     segment generator looks ahead through the planner buffer and plans the next ramp, or a cruise up
+     to the point where the next deceleration must begin, such that the profile stays under every
+     upcoming junction limit, including the stop at the end of the buffer. An S-curve deceleration
+     that ends at a junction limit stays under the planner's constant deceleration to it, so the
+     executed profile never exceeds the plan. Each ramp uses the lowest acceleration and jerk limits
+     of the blocks it spans. In the profile variables, the maximum speed is the
+     target of an acceleration ramp or the cruise speed, the exit speed is the target of the next
+     deceleration, and the deceleration point is measured from the end of the current block, which
+     may place it in a later block.
+  */
+
+  // Computes the duration of an S-curve ramp over the given speed change, using the acceleration
+  // and jerk limits of the planned profile. The duration of each jerk phase is returned through
+  // jerk_time.
+  static float st_compute_ramp_time(float delta_speed, float *jerk_time)
+  {
+    *jerk_time = prep.acceleration/prep.jerk;
+    if (delta_speed > prep.acceleration*(*jerk_time)) { // Reaches full acceleration.
+      return(delta_speed/prep.acceleration + *jerk_time);
+    }
+    *jerk_time = sqrt(delta_speed/prep.jerk);
+    return(2.0*(*jerk_time));
+  }
+
+
+  // Computes the distance traveled by an S-curve ramp between two speeds (mm).
+  static float st_compute_ramp_distance(float start_speed, float end_speed)
+  {
+    float jerk_time;
+    return(0.5*(start_speed+end_speed)*st_compute_ramp_time(fabs(end_speed-start_speed),&jerk_time));
+  }
+
+
+  // Sets up the active S-curve ramp between two speeds, starting at the given distance from the end
+  // of the block.
+  static void st_ramp_init(float start_speed, float end_speed, float origin)
+  {
+    prep.ramp_start_speed = start_speed;
+    prep.ramp_delta_speed = end_speed-start_speed;
+    prep.ramp_time = st_compute_ramp_time(fabs(prep.ramp_delta_speed),&prep.ramp_jerk_time);
+    if (prep.ramp_delta_speed < 0.0) { prep.ramp_jerk = -prep.jerk; }
+    else { prep.ramp_jerk = prep.jerk; }
+    prep.ramp_elapsed = 0.0;
+    prep.ramp_origin = origin;
+  }
+
+
+  // Returns the speed of the active S-curve ramp at time t (mm/min).
+  static float st_ramp_speed(float t)
+  {
+    float jerk_time = prep.ramp_jerk_time;
+    if (t < jerk_time) { return(prep.ramp_start_speed + 0.5*prep.ramp_jerk*t*t); } // Jerk-in
+    float t_end = prep.ramp_time-t;
+    if (t_end < jerk_time) { // Jerk-out
+      return(prep.ramp_start_speed + prep.ramp_delta_speed - 0.5*prep.ramp_jerk*t_end*t_end);
+    }
+    return(prep.ramp_start_speed + prep.ramp_jerk*jerk_time*(t-0.5*jerk_time)); // Full acceleration
+  }
+
+
+  // Returns the distance traveled by the active S-curve ramp at time t (mm).
+  static float st_ramp_distance(float t)
+  {
+    float jerk_time = prep.ramp_jerk_time;
+    float mm = prep.ramp_start_speed*t;
+    if (t < jerk_time) { return(mm + prep.ramp_jerk*t*t*t/6.0); } // Jerk-in
+    float t_end = prep.ramp_time-t;
+    if (t_end < jerk_time) { // Jerk-out
+      return(mm + prep.ramp_delta_speed*(0.5*prep.ramp_time-t_end) + prep.ramp_jerk*t_end*t_end*t_end/6.0);
+    }
+    t -= jerk_time; // Full acceleration
+    return(mm + prep.ramp_jerk*jerk_time*(jerk_time*jerk_time/6.0 + 0.5*jerk_time*t + 0.5*t*t));
+  }
+
+
+  // Returns the time at which the active S-curve ramp has traveled the given distance, which must
+  // lie within the remainder of the ramp. Solved by Newton's method from the elapsed ramp time. The
+  // ramp distance is monotonic and, within a ramp, either convex or concave, so the iterations
+  // converge without bracketing.
+  static float st_ramp_time_at_distance(float mm)
+  {
+    float t = prep.ramp_elapsed;
+    float speed;
+    uint8_t iterations = 6;
+    while (iterations--) {
+      speed = st_ramp_speed(t);
+      if (speed <= 0.0) { break; }
+      t += (mm-st_ramp_distance(t))/speed;
+      if (t > prep.ramp_time) { t = prep.ramp_time; }
+      else if (t < prep.ramp_elapsed) { t = prep.ramp_elapsed; }
+    }
+    return(t);
+  }
+
+
+  // Advances the active S-curve ramp by the segment time variable, up to the given distance from the
+  // end of the block. Updates the segment distance remaining and the current speed. Returns true when
+  // the ramp completes or reaches mm_end, in which case the segment time variable is truncated to the
+  // time it took to get there.
+  static uint8_t st_ramp_advance(float *mm_remaining, float *time_var, float mm_end)
+  {
+    float t = prep.ramp_elapsed + *time_var;
+    float mm_var;
+    if (t < prep.ramp_time) {
+      mm_var = prep.ramp_origin - st_ramp_distance(t);
+      if (mm_var > mm_end) { // Mid-ramp.
+        *mm_remaining = mm_var;
+        prep.current_speed = st_ramp_speed(t);
+        prep.ramp_elapsed = t;
+        return(false);
+      }
+    }
+    mm_var = prep.ramp_origin - st_ramp_distance(prep.ramp_time);
+    if (mm_var < mm_end) { // Ramp continues past mm_end, such as into the next block.
+      t = st_ramp_time_at_distance(prep.ramp_origin-mm_end);
+      mm_var = mm_end;
+    } else { // End of ramp.
+      t = prep.ramp_time;
+    }
+    *time_var = t - prep.ramp_elapsed;
+    *mm_remaining = mm_var;
+    prep.current_speed = st_ramp_speed(t);
+    prep.ramp_elapsed = t;
+    return(true);
+  }
+
+
+  // Checks if an S-curve deceleration from the given speed, begun at the given distance ahead, may end
+  // at the target speed. It must end before any lower junction limit, and leave enough room to meet
+  // each lower binding limit with a ramp of its own, since a ramp always ends at zero acceleration.
+  static uint8_t st_check_ramp_target(float speed, float target_speed, float decel_mm)
+  {
+    float mm_ramp = decel_mm + st_compute_ramp_distance(speed,target_speed);
+    float mm_var;
+    uint8_t idx;
+    for (idx=0; idx<st_junction_count; idx++) {
+      if ((st_junction[idx].mm > 0.0) && (st_junction[idx].speed < target_speed)) {
+        mm_var = st_junction[idx].mm - mm_ramp;
+        if (st_junction[idx].binding) {
+          mm_var -= st_compute_ramp_distance(target_speed,st_junction[idx].speed);
+        }
+        if (mm_var < 0.0) { return(false); }
+      }
+    }
+    return(true);
+  }
+
+
+  // Lowers the acceleration and jerk limits of the planned S-curve ramps to those of every block the
+  // ramps enter within the given distance ahead, measured from the given distance from the end of
+  // the prepped block. Returns true if any limit was lowered.
+  static uint8_t st_limit_ramp_span(float mm_remaining, float mm_span)
+  {
+    uint8_t is_lowered = false;
+    plan_block_t *block = pl_block;
+    float mm_ahead = mm_remaining;
+    if (sys.step_control & STEP_CONTROL_EXECUTE_SYS_MOTION) { return(false); }
+    while (mm_ahead < mm_span) {
+      block = plan_get_next_block(block);
+      if (block == NULL) { break; }
+      #ifdef ENABLE_DWELL_BLOCKS
+        if (block->step_event_count == 0) { break; } // Motion stops at a dwell block.
+      #endif
+      if (block->acceleration < prep.acceleration) {
+        prep.acceleration = block->acceleration;
+        is_lowered = true;
+      }
+      if (block->jerk < prep.jerk) {
+        prep.jerk = block->jerk;
+        is_lowered = true;
+      }
+      mm_ahead += block->millimeters;
+    }
+    return(is_lowered);
+  }
+
+
+  // Looks ahead through the planner buffer from the given speed, reached at zero acceleration at the
+  // given distance from the end of the prepped block. Sets the highest speed an S-curve ramp may
+  // reach before it must decelerate for any upcoming junction limit as the maximum speed, and the
+  // deceleration target as the exit speed. Returns the distance ahead at which the deceleration must
+  // begin, which is negative if overdue. The ramps use the lowest acceleration and jerk limits of
+  // the blocks they span, which are found by replanning until none are lowered.
+  // NOTE: Only the junctions within reach of the profile before it is next replanned are checked.
+  static float st_compute_ramp_limits(float speed, float mm_remaining)
+  {
+    float nominal_speed = plan_compute_profile_nominal_speed(pl_block);
+    float limit_speed, mm_reach, mm_ahead, decel_mm, mm_span;
+    float speed_min, speed_max;
+    plan_block_t *block;
+    uint8_t idx, k, iterations;
+
+    prep.acceleration = pl_block->acceleration;
+    prep.jerk = pl_block->jerk;
+    do {
+      // Collect the junction limits within reach, ending with the stop at the end of the buffer.
+      // System motions, like parking, execute alone.
+      limit_speed = max(speed,nominal_speed);
+      mm_reach = max(mm_remaining,0.0) + st_compute_ramp_distance(speed,limit_speed)
+                 + st_compute_ramp_distance(limit_speed,0.0);
+      mm_ahead = mm_remaining;
+      block = pl_block;
+      st_junction_count = 0;
+      while (1) {
+        if (sys.step_control & STEP_CONTROL_EXECUTE_SYS_MOTION) { block = NULL; }
+        else { block = plan_get_next_block(block); }
+        st_junction[st_junction_count].mm = mm_ahead;
+        if (block == NULL) { // Stop at the end of the buffer.
+          st_junction[st_junction_count++].speed = 0.0;
+          break;
+        }
+        st_junction[st_junction_count++].speed = min(sqrt(block->entry_speed_sqr),plan_compute_profile_nominal_speed(block));
+        if (mm_ahead >= mm_reach) { break; }
+        mm_ahead += block->millimeters;
+      }
+
+      // Most planner junction limits follow from a lower one further ahead by constant deceleration.
+      // Since an S-curve deceleration that meets the further limit stays under this curve, only the
+      // remaining limits bind the profile.
+      for (idx=0; idx<st_junction_count; idx++) {
+        st_junction[idx].binding = true;
+        for (k=idx+1; k<st_junction_count; k++) {
+          if (st_junction[idx].speed*st_junction[idx].speed >= RAMP_ENVELOPE_TOLERANCE*(st_junction[k].speed*st_junction[k].speed +
+              2*prep.acceleration*(st_junction[k].mm-st_junction[idx].mm))) {
+            st_junction[idx].binding = false;
+            break;
+          }
+        }
+      }
+
+      // Find the most urgent deceleration and limit the maximum speed, such that the ramp up to it
+      // and back down fits before every binding limit. The combined ramp distance has no closed-form
+      // inverse, so the maximum speed is found by bisection. Junctions behind the given distance, as
+      // when checking the end of a ramp in progress, no longer apply.
+      decel_mm = SOME_LARGE_VALUE;
+      prep.maximum_speed = nominal_speed;
+      prep.exit_speed = speed;
+      if (speed > nominal_speed) { // Only occurs with a feed rate override reduction.
+        decel_mm = -st_compute_ramp_distance(speed,nominal_speed);
+        prep.exit_speed = nominal_speed;
+      }
+      for (idx=0; idx<st_junction_count; idx++) {
+        mm_ahead = st_junction[idx].mm;
+        if ((mm_ahead <= 0.0) || !st_junction[idx].binding) { continue; }
+        limit_speed = st_junction[idx].speed;
+        if (limit_speed < speed) {
+          decel_mm = min(decel_mm,mm_ahead-st_compute_ramp_distance(speed,limit_speed));
+          prep.exit_speed = min(prep.exit_speed,limit_speed);
+        }
+        if ((limit_speed < prep.maximum_speed) && (prep.maximum_speed > speed)) {
+          if (st_compute_ramp_distance(speed,prep.maximum_speed) +
+              st_compute_ramp_distance(prep.maximum_speed,limit_speed) > mm_ahead) {
+            speed_min = max(speed,limit_speed);
+            speed_max = prep.maximum_speed;
+            iterations = 10;
+            while (iterations--) {
+              prep.maximum_speed = 0.5*(speed_min+speed_max);
+              if (st_compute_ramp_distance(speed,prep.maximum_speed) +
+                  st_compute_ramp_distance(prep.maximum_speed,limit_speed) > mm_ahead) {
+                speed_max = prep.maximum_speed;
+              } else {
+                speed_min = prep.maximum_speed;
+              }
+            }
+            prep.maximum_speed = speed_min;
+          }
+        }
+      }
+      if (prep.maximum_speed < MINIMUM_FEED_RATE) { prep.maximum_speed = MINIMUM_FEED_RATE; }
+
+      // A deceleration to the lowest limit ahead, begun no later than the most urgent one, passes
+      // under every limit. Target the highest limit that is still safe instead.
+      mm_span = 0.0;
+      if (prep.exit_speed < speed) {
+        if ((speed > nominal_speed) && st_check_ramp_target(speed,nominal_speed,decel_mm)) {
+          prep.exit_speed = nominal_speed;
+        } else {
+          for (idx=0; idx<st_junction_count; idx++) {
+            if ((st_junction[idx].mm <= 0.0) || !st_junction[idx].binding) { continue; }
+            limit_speed = st_junction[idx].speed;
+            if ((limit_speed > prep.exit_speed) && (limit_speed < speed) && (limit_speed <= nominal_speed)) {
+              if (st_check_ramp_target(speed,limit_speed,decel_mm)) { prep.exit_speed = limit_speed; }
+            }
+          }
+        }
+        mm_span = decel_mm + st_compute_ramp_distance(speed,prep.exit_speed);
+      }
+      if (prep.maximum_speed > speed) {
+        mm_span = max(mm_span,st_compute_ramp_distance(speed,prep.maximum_speed));
+      }
+    } while (st_limit_ramp_span(mm_remaining,mm_span));
+    return(decel_mm);
+  }
+
+
+  // Plans the next part of the S-curve velocity profile from the current speed, reached at zero
+  // acceleration at the given distance from the end of the prepped block. Either decelerates when
+  // due, accelerates when there is a worthwhile speed gain, or cruises until the next deceleration.
+  static void st_plan_ramp(float mm_remaining)
+  {
+    float decel_mm = st_compute_ramp_limits(prep.current_speed,mm_remaining);
+    if (decel_mm <= 0.0) {
+      prep.ramp_type = RAMP_DECEL;
+      st_ramp_init(prep.current_speed,prep.exit_speed,mm_remaining);
+    } else if (prep.maximum_speed > RAMP_MIN_SPEED_GAIN*prep.current_speed) {
+      prep.ramp_type = RAMP_ACCEL;
+      st_ramp_init(prep.current_speed,prep.maximum_speed,mm_remaining);
+    } else {
+      prep.ramp_type = RAMP_CRUISE;
+      prep.maximum_speed = prep.current_speed;
+      prep.decelerate_after = mm_remaining-decel_mm;
+    }
+  }
+#endif
+
+
 #ifdef PARKING_ENABLE
   // Changes the run state of the step segment buffer to execute the special parking motion.
   void st_parking_setup_buffer()
@@ -588,6 +1157,240 @@ static uint8_t st_next_block_index(uint8_t block_index)
 #endif
 
 
+#ifdef FIXED_POINT_SEGMENTS
+  // Integrates a whole segment of the current ramp in fixed-point, which takes only a few integer adds.
+  // Returns false without changing the ramp state, if the segment would reach the end of the ramp or of
+  // the velocity profile, or travel less than the minimum segment distance. These segments are computed
+  // by the float segment generator instead.
+  static uint8_t st_prep_fixed_segment()
+  {
+    int32_t speed = prep.speed;
+    int32_t dist_end;
+    switch (prep.ramp_type) {
+      case RAMP_ACCEL:
+        speed += prep.acceleration;
+        dist_end = prep.dist_accelerate_until;
+        break;
+      case RAMP_CRUISE:
+        dist_end = prep.dist_decelerate_after;
+        break;
+      case RAMP_DECEL_OVERRIDE:
+        speed -= prep.acceleration;
+        dist_end = prep.dist_accelerate_until;
+        break;
+      default: // case RAMP_DECEL:
+        speed -= prep.acceleration;
+        dist_end = prep.dist_complete;
+    }
+    if (speed <= 0) { return(false); }
+
+    // Distance traveled at the average segment speed, in whole distance units. The fraction left over
+    // is carried to the next segment. Otherwise, the same fraction may be dropped in every segment of a
+    // ramp, since the speed changes by the same amount each time.
+    int32_t dist = prep.speed + speed + prep.dist_fraction;
+    uint16_t dist_fraction = dist & ((1 << (FIXED_SPEED_SHIFT-FIXED_DIST_SHIFT+1))-1);
+    dist >>= (FIXED_SPEED_SHIFT-FIXED_DIST_SHIFT+1);
+    if (dist < prep.dist_minimum) { return(false); }
+    dist = prep.dist_remaining - dist;
+    if (dist <= dist_end) { return(false); }
+
+    prep.dist_remaining = dist;
+    prep.dist_fraction = dist_fraction;
+    prep.speed = speed;
+    return(true);
+  }
+#endif
+
+
+#ifdef ENABLE_LASER_PPI
+  // Returns the laser pulse distance counter increment per step event of a line of the pulsed block
+  // being prepped. Zero, if the block is not pulsed.
+  static uint32_t st_ppi_increment(float millimeters, uint32_t step_event_count)
+  {
+    if ((prep.ppi_pulses_per_mm == 0.0) || (step_event_count == 0)) { return(0); }
+    float pulses = prep.ppi_pulses_per_mm*millimeters/step_event_count;
+    if (pulses >= 1.0) { return(PPI_PULSE_SPACING); }
+    return(max(1,lround(pulses*PPI_PULSE_SPACING)));
+  }
+#endif
+
+
+#ifdef ENABLE_NATIVE_ARCS
+  // Prepares the Bresenham data of the next chord of an arc block. The chord ends at the nearest step
+  // to the arc at mm_remaining from the end of the block, or exactly at the block target when complete.
+  // Each chord executes as a line with its own stepper block data, so a new one is taken once the last
+  // is in use by a queued segment. Returns the number of step events of the chord. A chord without
+  // steps is not prepped and leaves the stepper block data untouched.
+  static uint32_t st_prep_arc_chord(float mm_remaining)
+  {
+    int32_t target_steps[N_AXIS];
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      target_steps[idx] = pl_block->steps[idx];
+      if (pl_block->direction_bits & get_direction_pin_mask(idx)) { target_steps[idx] = -target_steps[idx]; }
+    }
+    if (mm_remaining > 0.0) {
+      // Interpolate the linear axes and rotate the start radius vector about the arc center.
+      float fraction = 1.0 - mm_remaining/prep.arc_millimeters;
+      for (idx=0; idx<N_AXIS; idx++) { target_steps[idx] = lround(fraction*target_steps[idx]); }
+      float theta = fraction*pl_block->arc_travel;
+      float cos_theta = cos(theta);
+      float sin_theta = sin(theta);
+      uint8_t axis_0 = pl_block->arc_axis_0;
+      uint8_t axis_1 = pl_block->arc_axis_1;
+      target_steps[axis_0] = lround( (pl_block->arc_offset[0]*(1.0-cos_theta) + pl_block->arc_offset[1]*sin_theta)
+                                     *settings.steps_per_mm[axis_0] );
+      target_steps[axis_1] = lround( (pl_block->arc_offset[1]*(1.0-cos_theta) - pl_block->arc_offset[0]*sin_theta)
+                                     *settings.steps_per_mm[axis_1] );
+    }
+
+    // Step the chord from the end of the last one. Nothing is prepped, if the chord has no steps.
+    uint32_t step_event_count = 0;
+    for (idx=0; idx<N_AXIS; idx++) {
+      target_steps[idx] -= prep.arc_steps[idx];
+      prep.arc_steps[idx] += target_steps[idx];
+      step_event_count = max(step_event_count, (uint32_t)labs(target_steps[idx]));
+    }
+    if (step_event_count == 0) { return(0); }
+
+    if (prep.arc_chord_queued) {
+      uint8_t st_block_index = st_next_block_index(prep.st_block_index);
+      #ifdef VARIABLE_SPINDLE
+        st_block_buffer[st_block_index].is_pwm_rate_adjusted = st_prep_block->is_pwm_rate_adjusted;
+      #endif
+      #ifdef ENABLE_RASTER_MODE
+        st_block_buffer[st_block_index].raster_steps = 0; // Arcs are never raster scanlines.
+      #endif
+      #ifdef COOLANT_WITHOUT_SYNC
+        st_block_buffer[st_block_index].coolant_condition = st_prep_block->coolant_condition;
+      #endif
+      prep.st_block_index = st_block_index;
+      st_prep_block = &st_block_buffer[st_block_index];
+    }
+
+    // Shifted like the block data loaded in st_prep_buffer().
+    st_prep_block->direction_bits = 0;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (target_steps[idx] < 0) { st_prep_block->direction_bits |= get_direction_pin_mask(idx); }
+      #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        st_prep_block->steps[idx] = labs(target_steps[idx]) << 1;
+      #else
+        st_prep_block->steps[idx] = labs(target_steps[idx]) << MAX_AMASS_LEVEL;
+      #endif
+    }
+    #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      st_prep_block->step_event_count = step_event_count << 1;
+    #else
+      st_prep_block->step_event_count = step_event_count << MAX_AMASS_LEVEL;
+    #endif
+    #ifdef ENABLE_LASER_PPI
+      // Pulse spacing follows the chord length, which differs from the arc length by the tolerance.
+      float chord_mm = 0.0;
+      for (idx=0; idx<N_AXIS; idx++) {
+        float axis_mm = target_steps[idx]/settings.steps_per_mm[idx];
+        chord_mm += axis_mm*axis_mm;
+      }
+      st_prep_block->ppi_increment = st_ppi_increment(sqrt(chord_mm), step_event_count);
+    #endif
+    return(step_event_count);
+  }
+#endif
+
+
+#ifdef ENABLE_DWELL_BLOCKS
+  // Prepares the next segment of a dwell block, if the planner block to execute is one. A dwell has
+  // no steps, so it is timed by step events without step outputs at one every millisecond. The stepper
+  // ISR keeps running through it, while the spindle and coolant states of the block are held. Returns
+  // false, if the block to execute is not a dwell block.
+  static uint8_t st_prep_dwell_segment()
+  {
+    if (pl_block == NULL) {
+      if (sys.step_control & STEP_CONTROL_EXECUTE_SYS_MOTION) { return(false); }
+      plan_block_t *block = plan_get_current_block();
+      if ((block == NULL) || block->step_event_count) { return(false); }
+      pl_block = block;
+
+      if (prep.recalculate_flag & PREP_FLAG_RECALCULATE) {
+        // Resume the dwell after a feed hold. Its remaining time is kept in the planner block.
+        #ifdef PARKING_ENABLE
+          if (prep.recalculate_flag & PREP_FLAG_PARKING) { prep.recalculate_flag &= ~(PREP_FLAG_RECALCULATE); }
+          else { prep.recalculate_flag = false; }
+        #else
+          prep.recalculate_flag = false;
+        #endif
+      } else {
+        // Load stepper block data without steps. Keep the direction outputs of the last block.
+        uint8_t direction_bits = st_block_buffer[prep.st_block_index].direction_bits;
+        prep.st_block_index = st_next_block_index(prep.st_block_index);
+        st_prep_block = &st_block_buffer[prep.st_block_index];
+        memset(st_prep_block, 0, sizeof(st_block_t));
+        st_prep_block->direction_bits = direction_bits;
+        #ifdef VARIABLE_SPINDLE
+          // Laser power adjusted by rate is off while stopped, as at the end of a motion.
+          if ((settings.flags & BITFLAG_LASER_MODE) && (pl_block->condition & PL_COND_FLAG_SPINDLE_CCW)) {
+            st_prep_block->is_pwm_rate_adjusted = true;
+          }
+        #endif
+        #ifdef COOLANT_WITHOUT_SYNC
+          st_prep_block->coolant_condition = pl_block->condition & (PL_COND_FLAG_COOLANT_FLOOD | PL_COND_FLAG_COOLANT_MIST);
+        #endif
+        prep.recalculate_flag &= ~(PREP_FLAG_DECEL_OVERRIDE);
+      }
+      prep.current_speed = 0.0;
+      #ifdef VARIABLE_SPINDLE
+        bit_true(sys.step_control, STEP_CONTROL_UPDATE_SPINDLE_PWM); // Force update whenever updating block.
+      #endif
+    } else if (pl_block->step_event_count) { return(false); }
+
+    if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) {
+      // Stop the dwell for a feed hold. The remaining time executes when the cycle resumes.
+      bit_true(sys.step_control,STEP_CONTROL_END_MOTION);
+      #ifdef PARKING_ENABLE
+        if (!(prep.recalculate_flag & PREP_FLAG_PARKING)) { prep.recalculate_flag |= PREP_FLAG_HOLD_PARTIAL_BLOCK; }
+      #endif
+      return(true);
+    }
+
+    segment_t *prep_segment = &segment_buffer[segment_buffer_head];
+    prep_segment->st_block_index = prep.st_block_index;
+    uint16_t n_step = 1000/ACCELERATION_TICKS_PER_SECOND; // Milliseconds per segment
+    if (pl_block->dwell_ms < n_step) { n_step = pl_block->dwell_ms; }
+    prep_segment->n_step = n_step;
+    prep_segment->cycles_per_tick = TICKS_PER_MICROSECOND*1000; // One step event per millisecond
+    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      prep_segment->amass_level = 0;
+    #else
+      prep_segment->prescaler = 1; // prescaler: 0
+    #endif
+
+    #ifdef VARIABLE_SPINDLE
+      if (sys.step_control & STEP_CONTROL_UPDATE_SPINDLE_PWM) {
+        if ((pl_block->condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) &&
+            !st_prep_block->is_pwm_rate_adjusted) {
+          prep.current_spindle_pwm = spindle_compute_pwm_value(pl_block->spindle_speed);
+        } else {
+          sys.spindle_speed = 0.0;
+          prep.current_spindle_pwm = SPINDLE_PWM_OFF_VALUE;
+        }
+        bit_false(sys.step_control,STEP_CONTROL_UPDATE_SPINDLE_PWM);
+      }
+      prep_segment->spindle_pwm = prep.current_spindle_pwm; // Reload segment PWM value
+    #endif
+
+    // Segment complete! Increment segment buffer indices, so stepper ISR can immediately execute it.
+    segment_buffer_head = segment_next_head;
+    if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+
+    pl_block->dwell_ms -= n_step;
+    if (pl_block->dwell_ms == 0) { // End of planner block
+      pl_block = NULL;
+      plan_discard_current_block();
+    }
+    return(true);
+  }
+#endif
+
+
 /* Prepares step segment buffer. Continuously called from main program.
 
    The segment buffer is an intermediary buffer interface between the execution of steps
@@ -608,6 +1411,13 @@ void st_prep_buffer()
 
   while (segment_buffer_tail != segment_next_head) { // Check if we need to fill the buffer.
 
+    #ifdef ENABLE_DWELL_BLOCKS
+      if (st_prep_dwell_segment()) {
+        if (bit_istrue(sys.step_control,STEP_CONTROL_END_MOTION)) { return; } // Dwell stopped by feed hold.
+        continue;
+      }
+    #endif
+
     // Determine if we need to load a new planner block or if the block needs to be recomputed.
     if (pl_block == NULL) {
 
@@ -647,21 +1457,55 @@ void st_prep_buffer()
           for (idx=0; idx<N_AXIS; idx++) { st_prep_block->steps[idx] = pl_block->steps[idx] << MAX_AMASS_LEVEL; }
           st_prep_block->step_event_count = pl_block->step_event_count << MAX_AMASS_LEVEL;
         #endif
+        #ifdef ENABLE_RASTER_MODE
+          // Raster blocks consume their pixels from the raster buffer in planned order.
+          #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+            st_prep_block->raster_steps = ((uint32_t)pl_block->raster_pixels << 1);
+          #else
+            st_prep_block->raster_steps = ((uint32_t)pl_block->raster_pixels << MAX_AMASS_LEVEL);
+          #endif
+          st_prep_block->raster_index = prep.raster_index;
+          uint16_t raster_index = prep.raster_index + pl_block->raster_pixels;
+          if (raster_index >= RASTER_BUFFER_SIZE) { raster_index -= RASTER_BUFFER_SIZE; }
+          prep.raster_index = raster_index;
+        #endif
+
+        #ifdef COOLANT_WITHOUT_SYNC
+          st_prep_block->coolant_condition = pl_block->condition &
+            (PL_COND_FLAG_SYSTEM_MOTION | PL_COND_FLAG_COOLANT_FLOOD | PL_COND_FLAG_COOLANT_MIST);
+        #endif
 
         // Initialize segment buffer data for generating the segments.
         prep.steps_remaining = (float)pl_block->step_event_count;
         prep.step_per_mm = prep.steps_remaining/pl_block->millimeters;
         prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm;
         prep.dt_remainder = 0.0; // Reset for new segment block
+        #ifdef ENABLE_NATIVE_ARCS
+          prep.arc_chord_queued = false;
+          if (pl_block->arc_travel != 0.0) {
+            // Arc blocks are stepped chord by chord from the block start, not by block step distance.
+            // Scale the minimum segment distance to a few steps of the coarser plane axis instead.
+            prep.arc_millimeters = pl_block->millimeters;
+            memset(prep.arc_steps, 0, sizeof(prep.arc_steps));
+            prep.step_per_mm = 0.5*min(settings.steps_per_mm[pl_block->arc_axis_0],settings.steps_per_mm[pl_block->arc_axis_1]);
+            prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm;
+          }
+        #endif
 
-        if ((sys.step_control & STEP_CONTROL_EXECUTE_HOLD) || (prep.recalculate_flag & PREP_FLAG_DECEL_OVERRIDE)) {
-          // New block loaded mid-hold. Override planner block entry speed to enforce deceleration.
-          prep.current_speed = prep.exit_speed;
-          pl_block->entry_speed_sqr = prep.exit_speed*prep.exit_speed;
-          prep.recalculate_flag &= ~(PREP_FLAG_DECEL_OVERRIDE);
-        } else {
-          prep.current_speed = sqrt(pl_block->entry_speed_sqr);
-        }
+        #ifdef JERK_LIMITED_PROFILES
+          // S-curve profiles carry the current speed and any ramp in progress across blocks. Override
+          // the planner block entry speed to match, like a new block loaded mid-hold.
+          pl_block->entry_speed_sqr = prep.current_speed*prep.current_speed;
+        #else
+          if ((sys.step_control & STEP_CONTROL_EXECUTE_HOLD) || (prep.recalculate_flag & PREP_FLAG_DECEL_OVERRIDE)) {
+            // New block loaded mid-hold. Override planner block entry speed to enforce deceleration.
+            prep.current_speed = prep.exit_speed;
+            pl_block->entry_speed_sqr = prep.exit_speed*prep.exit_speed;
+            prep.recalculate_flag &= ~(PREP_FLAG_DECEL_OVERRIDE);
+          } else {
+            prep.current_speed = sqrt(pl_block->entry_speed_sqr);
+          }
+        #endif
         
         #ifdef VARIABLE_SPINDLE
           // Setup laser mode variables. PWM rate adjusted motions will always complete a motion with the
@@ -671,10 +1515,29 @@ void st_prep_buffer()
             if (pl_block->condition & PL_COND_FLAG_SPINDLE_CCW) { 
               // Pre-compute inverse programmed rate to speed up PWM updating per step segment.
               prep.inv_rate = 1.0/pl_block->programmed_rate;
+              #ifdef LASER_PWM_STEP_RATE
+                prep.programmed_cycles = (TICKS_PER_MICROSECOND*1000000*60)*prep.inv_rate/prep.step_per_mm;
+              #endif
               st_prep_block->is_pwm_rate_adjusted = true; 
             }
           }
         #endif
+        #ifdef ENABLE_LASER_PPI
+          // Laser motions with a PPI set are pulsed at a fixed spacing, which keeps the energy per
+          // distance constant instead of scaling the power with speed.
+          prep.ppi_pulses_per_mm = 0.0;
+          if ((settings.flags & BITFLAG_LASER_MODE) && (settings.laser_ppi > 0.0) && (pl_block->spindle_speed > 0.0) &&
+              (pl_block->condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW))) {
+            #ifdef ENABLE_RASTER_MODE
+              if (!pl_block->raster_pixels)
+            #endif
+            {
+              prep.ppi_pulses_per_mm = settings.laser_ppi*(1.0/MM_PER_INCH);
+              st_prep_block->is_pwm_rate_adjusted = false;
+            }
+          }
+          st_prep_block->ppi_increment = st_ppi_increment(pl_block->millimeters, pl_block->step_event_count);
+        #endif
       }
 
 			/* ---------------------------------------------------------------------------------
@@ -684,6 +1547,40 @@ void st_prep_buffer()
 			 hold, override the planner velocities and decelerate to the target exit speed.
 			*/
 			prep.mm_complete = 0.0; // Default velocity profile complete at 0.0mm from end of block.
+      #ifdef JERK_LIMITED_PROFILES
+        if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) { // [Forced Deceleration to Zero Velocity]
+          // Start an S-curve deceleration to zero speed when the feed hold begins, or otherwise
+          // continue the one in progress. The hold ramp may span any number of planner blocks.
+          prep.ramp_type = RAMP_DECEL;
+          if (!prep.ramp_hold) {
+            prep.acceleration = pl_block->acceleration;
+            prep.jerk = pl_block->jerk;
+            while (st_limit_ramp_span(pl_block->millimeters, st_compute_ramp_distance(prep.current_speed, 0.0))) { }
+            st_ramp_init(prep.current_speed, 0.0, 0.0);
+            prep.ramp_hold = true;
+          }
+          // Locate the ramp start relative to the end of this block and check where the ramp ends.
+          prep.ramp_origin = pl_block->millimeters + st_ramp_distance(prep.ramp_elapsed);
+          float decel_dist = prep.ramp_origin - st_ramp_distance(prep.ramp_time);
+          if (decel_dist > 0.0) { prep.mm_complete = decel_dist; } // End of feed hold.
+          // Otherwise, deceleration through entire planner block.
+        } else { // [Normal Operation]
+          // Continue a ramp in progress from the previous block, or from before the planner update,
+          // if the profile can still meet every junction limit once the ramp completes. A tolerance
+          // of one step absorbs the round-off of the previous plan. Otherwise, replan the profile
+          // from the current speed.
+          if (!prep.ramp_hold && (prep.ramp_elapsed < prep.ramp_time)) {
+            prep.ramp_origin = pl_block->millimeters + st_ramp_distance(prep.ramp_elapsed);
+            if (st_compute_ramp_limits(prep.ramp_start_speed+prep.ramp_delta_speed,
+                  prep.ramp_origin-st_ramp_distance(prep.ramp_time)) < -prep.req_mm_increment) {
+              st_plan_ramp(pl_block->millimeters);
+            }
+          } else {
+            st_plan_ramp(pl_block->millimeters);
+          }
+          prep.ramp_hold = false;
+        }
+      #else
 			float inv_2_accel = 0.5/pl_block->acceleration;
 			if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) { // [Forced Deceleration to Zero Velocity]
 				// Compute velocity profile parameters for a feed hold in-progress. This profile overrides
@@ -767,6 +1664,34 @@ void st_prep_buffer()
 					prep.maximum_speed = prep.exit_speed;
 				}
 			}
+
+      #ifdef FIXED_POINT_SEGMENTS
+        // Convert the velocity profile to fixed-point for the segment generator.
+        prep.dist_per_mm = prep.step_per_mm*(1UL << FIXED_DIST_SHIFT);
+        prep.mm_per_dist = 1.0/prep.dist_per_mm;
+        prep.speed_per_mm_min = prep.step_per_mm*DT_SEGMENT*(1UL << FIXED_SPEED_SHIFT);
+        prep.mm_min_per_speed = 1.0/prep.speed_per_mm_min;
+        prep.dist_remaining = lround(pl_block->millimeters*prep.dist_per_mm);
+        prep.dist_fraction = 0;
+        prep.dist_accelerate_until = lround(prep.accelerate_until*prep.dist_per_mm);
+        prep.dist_decelerate_after = lround(prep.decelerate_after*prep.dist_per_mm);
+        prep.dist_complete = lround(prep.mm_complete*prep.dist_per_mm);
+        prep.dist_minimum = ceil(prep.req_mm_increment*prep.dist_per_mm);
+        prep.speed = lround(prep.current_speed*prep.speed_per_mm_min);
+        prep.acceleration = lround(pl_block->acceleration*DT_SEGMENT*prep.speed_per_mm_min);
+      #endif
+      #endif
+
+      #ifdef ENABLE_NATIVE_ARCS
+        if (pl_block->arc_travel != 0.0) {
+          // Limit the arc segment time, so chords stay within the arc tolerance up to the fastest speed
+          // in the block. Same chord length as the arc segments in mc_arc().
+          float radius = hypot_f(pl_block->arc_offset[0], pl_block->arc_offset[1]);
+          float arc_speed = max(prep.current_speed, plan_compute_profile_nominal_speed(pl_block));
+          prep.arc_segment_time = 2.0*sqrt(settings.arc_tolerance*(2.0*radius-settings.arc_tolerance))/arc_speed;
+          if (prep.arc_segment_time > DT_SEGMENT) { prep.arc_segment_time = DT_SEGMENT; }
+        }
+      #endif
       
       #ifdef VARIABLE_SPINDLE
         bit_true(sys.step_control, STEP_CONTROL_UPDATE_SPINDLE_PWM); // Force update whenever updating block.
@@ -794,16 +1719,65 @@ void st_prep_buffer()
       such as from a feed hold.
     */
     float dt_max = DT_SEGMENT; // Maximum segment time
+    #ifdef ENABLE_NATIVE_ARCS
+      if (pl_block->arc_travel != 0.0) { dt_max = prep.arc_segment_time; }
+    #endif
     float dt = 0.0; // Initialize segment time
     float time_var = dt_max; // Time worker variable
     float mm_var; // mm-Distance worker variable
-    float speed_var; // Speed worker variable
+    #ifndef JERK_LIMITED_PROFILES
+      float speed_var; // Speed worker variable
+    #endif
     float mm_remaining = pl_block->millimeters; // New segment distance from end of block.
     float minimum_mm = mm_remaining-prep.req_mm_increment; // Guarantee at least one step.
     if (minimum_mm < 0.0) { minimum_mm = 0.0; }
 
+    #ifdef FIXED_POINT_SEGMENTS
+      uint32_t dt_cycles; // Segment time (cycles)
+      #ifdef ENABLE_NATIVE_ARCS
+        if ((pl_block->arc_travel == 0.0) && st_prep_fixed_segment()) {
+      #else
+        if (st_prep_fixed_segment()) {
+      #endif
+        // Whole segment within a ramp. Update the float state used by the rest of Grbl.
+        dt_cycles = CYCLES_PER_SEGMENT;
+        mm_remaining = prep.dist_remaining*prep.mm_per_dist;
+        prep.current_speed = prep.speed*prep.mm_min_per_speed;
+      } else {
+        if (prep.ramp_type == RAMP_DECEL) {
+          // Restore the exact speed for the distance left to decelerate. Otherwise, fixed-point rounding
+          // errors may leave a small distance to travel at near zero speed at the end of the ramp.
+          prep.current_speed = sqrt(prep.exit_speed*prep.exit_speed +
+                                    2*pl_block->acceleration*(mm_remaining-prep.mm_complete));
+        }
+    #endif
+
     do {
       switch (prep.ramp_type) {
+      #ifdef JERK_LIMITED_PROFILES
+        // NOTE: S-curve ramps are advanced in time from their start, rather than by segment distance.
+        case RAMP_CRUISE:
+          // Cruise until the next deceleration, which may begin beyond the end of this block.
+          mm_var = mm_remaining - prep.maximum_speed*time_var;
+          if (mm_var < max(prep.decelerate_after,prep.mm_complete)) { // End of cruise or end of block.
+            mm_var = max(prep.decelerate_after,prep.mm_complete);
+            time_var = (mm_remaining - mm_var)/prep.maximum_speed;
+            mm_remaining = mm_var;
+            if (mm_remaining == prep.decelerate_after) {
+              prep.ramp_type = RAMP_DECEL;
+              st_ramp_init(prep.maximum_speed, prep.exit_speed, mm_remaining);
+            }
+          } else { // Cruising only.
+            mm_remaining = mm_var;
+          }
+          break;
+        default: // case RAMP_ACCEL, RAMP_DECEL:
+          // Plan the rest of the profile when a ramp completes mid-block. Ramps that reach the end
+          // of the block, or a feed hold, continue when the next block is loaded.
+          if (st_ramp_advance(&mm_remaining, &time_var, prep.mm_complete)) {
+            if (!prep.ramp_hold && (mm_remaining > prep.mm_complete)) { st_plan_ramp(mm_remaining); }
+          }
+      #else
         case RAMP_DECEL_OVERRIDE:
           speed_var = pl_block->acceleration*time_var;
           mm_var = time_var*(prep.current_speed - 0.5*speed_var);
@@ -863,6 +1837,7 @@ void st_prep_buffer()
           time_var = 2.0*(mm_remaining-prep.mm_complete)/(prep.current_speed+prep.exit_speed);
           mm_remaining = prep.mm_complete;
           prep.current_speed = prep.exit_speed;
+      #endif
       }
       dt += time_var; // Add computed ramp time to total segment time.
       if (dt < dt_max) { time_var = dt_max - dt; } // **Incomplete** At ramp junction.
@@ -878,29 +1853,16 @@ void st_prep_buffer()
       }
     } while (mm_remaining > prep.mm_complete); // **Complete** Exit loop. Profile complete.
 
-    #ifdef VARIABLE_SPINDLE
-      /* -----------------------------------------------------------------------------------
-        Compute spindle speed PWM output for step segment
-      */
-      
-      if (st_prep_block->is_pwm_rate_adjusted || (sys.step_control & STEP_CONTROL_UPDATE_SPINDLE_PWM)) {
-        if (pl_block->condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) {
-          float rpm = pl_block->spindle_speed;
-          // NOTE: Feed and rapid overrides are independent of PWM value and do not alter laser power/rate.        
-          if (st_prep_block->is_pwm_rate_adjusted) { rpm *= (prep.current_speed * prep.inv_rate); }
-          // If current_speed is zero, then may need to be rpm_min*(100/MAX_SPINDLE_SPEED_OVERRIDE)
-          // but this would be instantaneous only and during a motion. May not matter at all.
-          prep.current_spindle_pwm = spindle_compute_pwm_value(rpm);
-        } else { 
-          sys.spindle_speed = 0.0;
-          prep.current_spindle_pwm = SPINDLE_PWM_OFF_VALUE;
-        }
-        bit_false(sys.step_control,STEP_CONTROL_UPDATE_SPINDLE_PWM);
+    #ifdef FIXED_POINT_SEGMENTS
+        // Resume in fixed-point from the end of the float segment. Round the distance up, like the float
+        // version rounds up the steps remaining, so a sliver of distance left in the block keeps its step.
+        dt_cycles = ceil((TICKS_PER_MICROSECOND*1000000*60)*dt);
+        prep.dist_remaining = ceil(mm_remaining*prep.dist_per_mm);
+        prep.dist_fraction = 0;
+        prep.speed = lround(prep.current_speed*prep.speed_per_mm_min);
       }
-      prep_segment->spindle_pwm = prep.current_spindle_pwm; // Reload segment PWM value
-
     #endif
-    
+
     /* -----------------------------------------------------------------------------------
        Compute segment step rate, steps to execute, and apply necessary rate corrections.
        NOTE: Steps are computed by direct scalar conversion of the millimeter distance
@@ -911,10 +1873,42 @@ void st_prep_buffer()
        Fortunately, this scenario is highly unlikely and unrealistic in CNC machines
        supported by Grbl (i.e. exceeding 10 meters axis travel at 200 step/mm).
     */
+    #ifdef FIXED_POINT_SEGMENTS
+      // Rounding to fixed-point may leave the distance remaining a little beyond the steps remaining, if
+      // the segment barely moved. Clamp it, so the segment never steps backwards.
+      if ((uint32_t)prep.dist_remaining > (prep.steps_remaining << FIXED_DIST_SHIFT)) {
+        prep.dist_remaining = prep.steps_remaining << FIXED_DIST_SHIFT;
+      }
+      // In fixed-point distance, the segment travels the steps remaining after the last segment, less the
+      // distance remaining now. This includes the partial step left over by the last segment.
+      uint32_t n_steps_remaining = ((uint32_t)prep.dist_remaining + ((1UL << FIXED_DIST_SHIFT)-1)) >> FIXED_DIST_SHIFT;
+      uint32_t step_dist = (prep.steps_remaining << FIXED_DIST_SHIFT) - prep.dist_remaining;
+      uint32_t partial_step_dist = (n_steps_remaining << FIXED_DIST_SHIFT) - prep.dist_remaining;
+      prep_segment->n_step = prep.steps_remaining-n_steps_remaining; // Compute number of steps to execute.
+      #ifdef ENABLE_NATIVE_ARCS
+        if (pl_block->arc_travel != 0.0) {
+          // Arc chords end on whole steps, so no partial step is carried to the next segment.
+          n_steps_remaining = 0;
+          partial_step_dist = 0;
+          prep_segment->n_step = st_prep_arc_chord(mm_remaining);
+          step_dist = (uint32_t)prep_segment->n_step << FIXED_DIST_SHIFT;
+          prep_segment->st_block_index = prep.st_block_index;
+        }
+      #endif
+    #else
     float step_dist_remaining = prep.step_per_mm*mm_remaining; // Convert mm_remaining to steps
     float n_steps_remaining = ceil(step_dist_remaining); // Round-up current steps remaining
     float last_n_steps_remaining = ceil(prep.steps_remaining); // Round-up last steps remaining
+    #ifdef ENABLE_NATIVE_ARCS
+      if (pl_block->arc_travel != 0.0) {
+        // Arc chords end on whole steps, so no partial step is carried to the next segment.
+        step_dist_remaining = n_steps_remaining = 0.0;
+        last_n_steps_remaining = st_prep_arc_chord(mm_remaining);
+        prep_segment->st_block_index = prep.st_block_index;
+      }
+    #endif
     prep_segment->n_step = last_n_steps_remaining-n_steps_remaining; // Compute number of steps to execute.
+    #endif
 
     // Bail if we are at the end of a feed hold and don't have a step to execute.
     if (prep_segment->n_step == 0) {
@@ -927,6 +1921,22 @@ void st_prep_buffer()
         #endif
         return; // Segment not generated, but current step data still retained.
       }
+      #ifdef ENABLE_NATIVE_ARCS
+        if (pl_block->arc_travel != 0.0) {
+          // Nearest step on the arc not reached yet. Carry the segment time over to the next chord.
+          #ifdef FIXED_POINT_SEGMENTS
+            prep.dt_remainder += dt_cycles;
+          #else
+            prep.dt_remainder += dt;
+          #endif
+          pl_block->millimeters = mm_remaining;
+          if (mm_remaining == 0.0) { // End of planner block
+            pl_block = NULL;
+            plan_discard_current_block();
+          }
+          continue;
+        }
+      #endif
     }
 
     // Compute segment step rate. Since steps are integers and mm distances traveled are not,
@@ -937,11 +1947,59 @@ void st_prep_buffer()
     // adjusts the whole segment rate to keep step output exact. These rate adjustments are
     // typically very small and do not adversely effect performance, but ensures that Grbl
     // outputs the exact acceleration and velocity profiles as computed by the planner.
+    #ifdef FIXED_POINT_SEGMENTS
+      dt_cycles += prep.dt_remainder; // Apply previous segment partial step execute time
+
+      // Compute CPU cycles per step for the prepped segment, rounded up. Segments longer than about half
+      // a second are shifted after the division to avoid an overflow, since they are very slow anyway.
+      // A segment that travels no distance at all has no step rate. Just set the slowest.
+      uint32_t cycles;
+      if (step_dist == 0) { cycles = (1UL << 24)-1; }
+      else if (dt_cycles < (1UL << 23)) { cycles = ((dt_cycles << FIXED_DIST_SHIFT) + step_dist-1)/step_dist; }
+      else { cycles = (dt_cycles/step_dist) << FIXED_DIST_SHIFT; }
+      if (cycles > ((1UL << 24)-1)) { cycles = (1UL << 24)-1; } // Beyond the slowest step timing anyway.
+      uint32_t dt_remainder = (partial_step_dist*cycles) >> FIXED_DIST_SHIFT;
+    #else
     dt += prep.dt_remainder; // Apply previous segment partial step execute time
     float inv_rate = dt/(last_n_steps_remaining - step_dist_remaining); // Compute adjusted step rate inverse
 
     // Compute CPU cycles per step for the prepped segment.
     uint32_t cycles = ceil( (TICKS_PER_MICROSECOND*1000000*60)*inv_rate ); // (cycles/step)
+    #endif
+
+    #ifdef VARIABLE_SPINDLE
+      /* -----------------------------------------------------------------------------------
+        Compute spindle speed PWM output for step segment
+      */
+      
+      if (st_prep_block->is_pwm_rate_adjusted || (sys.step_control & STEP_CONTROL_UPDATE_SPINDLE_PWM)) {
+        if (pl_block->condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) {
+          float rpm = pl_block->spindle_speed;
+          // NOTE: Feed and rapid overrides are independent of PWM value and do not alter laser power/rate.        
+          if (st_prep_block->is_pwm_rate_adjusted) {
+            #ifdef LASER_PWM_STEP_RATE
+              // Scale by the segment step rate. Arc chords have no fixed steps per mm, so use the speed.
+              #ifdef ENABLE_NATIVE_ARCS
+                if (pl_block->arc_travel != 0.0) { rpm *= (prep.current_speed * prep.inv_rate); }
+                else
+              #endif
+              { rpm *= (prep.programmed_cycles/cycles); }
+            #else
+              rpm *= (prep.current_speed * prep.inv_rate);
+            #endif
+          }
+          // If current_speed is zero, then may need to be rpm_min*(100/MAX_SPINDLE_SPEED_OVERRIDE)
+          // but this would be instantaneous only and during a motion. May not matter at all.
+          prep.current_spindle_pwm = spindle_compute_pwm_value(rpm);
+        } else { 
+          sys.spindle_speed = 0.0;
+          prep.current_spindle_pwm = SPINDLE_PWM_OFF_VALUE;
+        }
+        bit_false(sys.step_control,STEP_CONTROL_UPDATE_SPINDLE_PWM);
+      }
+      prep_segment->spindle_pwm = prep.current_spindle_pwm; // Reload segment PWM value
+
+    #endif
 
     #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
       // Compute step timing and multi-axis smoothing level.
@@ -977,11 +2035,18 @@ void st_prep_buffer()
     // Segment complete! Increment segment buffer indices, so stepper ISR can immediately execute it.
     segment_buffer_head = segment_next_head;
     if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+    #ifdef ENABLE_NATIVE_ARCS
+      if (pl_block->arc_travel != 0.0) { prep.arc_chord_queued = true; }
+    #endif
 
     // Update the appropriate planner and segment data.
     pl_block->millimeters = mm_remaining;
     prep.steps_remaining = n_steps_remaining;
-    prep.dt_remainder = (n_steps_remaining - step_dist_remaining)*inv_rate;
+    #ifdef FIXED_POINT_SEGMENTS
+      prep.dt_remainder = dt_remainder;
+    #else
+      prep.dt_remainder = (n_steps_remaining - step_dist_remaining)*inv_rate;
+    #endif
 
     // Check for exit conditions and flag to load next planner block.
     if (mm_remaining == prep.mm_complete) {
@@ -1021,3 +2086,33 @@ float st_get_realtime_rate()
   }
   return 0.0f;
 }
+
+
+#ifdef ENABLE_RASTER_MODE
+  // Returns the number of free pixels in the raster buffer. The pixel being executed is still in use.
+  uint8_t st_raster_buffer_available()
+  {
+    int16_t available = (int16_t)raster_buffer_tail - raster_buffer_head - 1;
+    if (available < 0) { available += RASTER_BUFFER_SIZE; }
+    return(available);
+  }
+
+
+  // Writes the spindle PWM value of a pixel, offset from the last committed pixel. Written pixels are
+  // only used once committed, so an uncommitted scanline is simply overwritten by the next one.
+  void st_raster_buffer_write(uint8_t offset, spindle_pwm_t pwm)
+  {
+    uint16_t index = raster_buffer_head + offset;
+    if (index >= RASTER_BUFFER_SIZE) { index -= RASTER_BUFFER_SIZE; }
+    raster_buffer[index] = pwm;
+  }
+
+
+  // Commits the written pixels of a raster block. Called by the planner when it adds the block.
+  void st_raster_buffer_commit(uint8_t count)
+  {
+    uint16_t index = raster_buffer_head + count;
+    if (index >= RASTER_BUFFER_SIZE) { index -= RASTER_BUFFER_SIZE; }
+    raster_buffer_head = index;
+  }
+#endif
@@ -56,4 +56,18 @@ void st_update_plan_block_parameters();
 // Called by realtime status reporting if realtime rate reporting is enabled in config.h.
 float st_get_realtime_rate();
 
+// Returns the real-time machine position in steps. Use instead of sys_position while moving.
+void st_get_realtime_position(int32_t *position);
+
+#ifdef ENABLE_RASTER_MODE
+  // Returns the number of free pixels in the raster buffer.
+  uint8_t st_raster_buffer_available();
+
+  // Writes a raster pixel spindle PWM value, offset from the last committed pixel.
+  void st_raster_buffer_write(uint8_t offset, spindle_pwm_t pwm);
+
+  // Commits the pixels written for a raster block added to the planner.
+  void st_raster_buffer_commit(uint8_t count);
+#endif
+
 #endif
@@ -31,9 +31,43 @@ void system_init()
   #endif
   CONTROL_PCMSK |= CONTROL_MASK;  // Enable specific pins of the Pin Change Interrupt
   PCICR |= (1 << CONTROL_INT);   // Enable Pin Change Interrupt
+  #ifdef ENABLE_AUTO_REPORT
+    system_auto_report_init();
+  #endif
 }
 
 
+#ifdef ENABLE_AUTO_REPORT
+  static uint8_t auto_report_ticks; // Watchdog ticks per automatic status report. Zero if disabled.
+  static volatile uint8_t auto_report_count;
+
+  void system_auto_report_init()
+  {
+    float ticks = ceil(settings.status_report_interval*(1.0/AUTO_REPORT_TICK_MS));
+    if (ticks > 255.0) { ticks = 255.0; }
+    auto_report_ticks = ticks;
+    auto_report_count = 0;
+    // Run the watchdog timer in interrupt mode, without system reset, at its ~16msec minimum timeout.
+    uint8_t sreg = SREG;
+    cli();
+    WDTCSR |= (1<<WDCE) | (1<<WDE);
+    if (auto_report_ticks) { WDTCSR = (1<<WDIE); }
+    else { WDTCSR = 0; }
+    SREG = sreg;
+  }
+
+
+  // Watchdog timer ISR. Flags an automatic status report every $14 interval.
+  ISR(WDT_vect)
+  {
+    if (++auto_report_count >= auto_report_ticks) {
+      auto_report_count = 0;
+      sys_rt_exec_auto_report = true;
+    }
+  }
+#endif
+
+
 // Returns control pin state as a uint8 bitfield. Each bit indicates the input pin state, where
 // triggered is 1 and not triggered is 0. Invert mask is applied. Bitfield organization is
 // defined by the CONTROL_PIN_INDEX in the header file.
@@ -165,6 +199,39 @@ uint8_t system_execute_line(char *line)
           break;
       }
       break;
+    #ifdef ENABLE_BINARY_STATUS_REPORT
+      case 'B' : // Select binary or text status reports [ANY]
+        if ((line[2] != '=') || (line[4] != 0)) { return(STATUS_INVALID_STATEMENT); }
+        switch (line[3]) {
+          case '0': sys.report_binary = false; break;
+          case '1': sys.report_binary = true; break;
+          default: return(STATUS_INVALID_STATEMENT);
+        }
+        #ifdef ENABLE_AUTO_REPORT
+          sys.report_last_valid = false; // Next report is complete in the selected format.
+        #endif
+        break;
+    #endif
+    #ifdef ENABLE_WINDOWED_ACKS
+      case 'W' : // Select windowed or per-line acknowledgements [ANY]
+        // NOTE: Any pending acknowledgements were sent before this line was executed.
+        if ((line[2] != '=') || (line[4] != 0)) { return(STATUS_INVALID_STATEMENT); }
+        switch (line[3]) {
+          case '0': sys.ack_windowed = false; break;
+          case '1': sys.ack_windowed = true; break;
+          default: return(STATUS_INVALID_STATEMENT);
+        }
+        sys.ack_sequence = 0; // Numbering restarts with this line as 1.
+        break;
+    #endif
+    #ifdef ENABLE_RASTER_MODE
+      case 'R' :
+        if (line[2] == '=') { // Raster scanline. Executes like g-code motion.
+          if (sys.state & (STATE_ALARM | STATE_JOG)) { return(STATUS_SYSTEM_GC_LOCK); }
+          return(raster_execute_line(line));
+        }
+        // Otherwise, a restore command. No break. Continues into default:.
+    #endif
     default :
       // Block any system command that requires the state as IDLE/ALARM. (i.e. EEPROM, homing)
       if ( !(sys.state == STATE_IDLE || sys.state == STATE_ALARM) ) { return(STATUS_IDLE_ERROR); }
@@ -143,11 +143,27 @@ typedef struct {
   #ifdef VARIABLE_SPINDLE
     float spindle_speed;
   #endif
+  #ifdef ENABLE_BINARY_STATUS_REPORT
+    uint8_t report_binary;     // Status reports are sent as binary frames. Set by $B=1 for the session.
+  #endif
+  #ifdef ENABLE_WINDOWED_ACKS
+    uint8_t ack_windowed;      // Lines are acknowledged in numbered batches. Set by $W=1 for the session.
+    uint8_t ack_count;         // Number of executed lines not yet acknowledged.
+    uint16_t ack_sequence;     // Sequence number of the last acknowledged line.
+  #endif
+  #ifdef ENABLE_LINE_CHECKSUMS
+    uint8_t line_checked;      // A line with a checksum was accepted. Numbered lines must then carry one.
+    int32_t line_number_last;  // Line number of the last line with a checksum accepted.
+  #endif
+  #ifdef ENABLE_AUTO_REPORT
+    uint8_t report_last_valid; // Tracks if a status report was sent since reset. Auto reports omit unchanged fields after.
+  #endif
 } system_t;
 extern system_t sys;
 
 // NOTE: These position variables may need to be declared as volatiles, if problems arise.
-extern int32_t sys_position[N_AXIS];      // Real-time machine (aka home) position vector in steps.
+extern int32_t sys_position[N_AXIS];      // Machine (aka home) position vector in steps. Real-time up to the
+                                          // last completed step segment. See st_get_realtime_position().
 extern int32_t sys_probe_position[N_AXIS]; // Last probe position in machine coordinates and steps.
 
 extern volatile uint8_t sys_probe_state;   // Probing state value.  Used to coordinate the probing cycle with stepper ISR.
@@ -161,9 +177,19 @@ extern volatile uint8_t sys_rt_exec_accessory_override; // Global realtime execu
   extern volatile uint8_t sys_rt_exec_debug;
 #endif
 
+#ifdef ENABLE_AUTO_REPORT
+  #define AUTO_REPORT_TICK_MS 16 // Watchdog timer interrupt period (msec)
+  extern volatile uint8_t sys_rt_exec_auto_report; // Set by the watchdog timer when an automatic status report is due.
+#endif
+
 // Initialize the serial protocol
 void system_init();
 
+#ifdef ENABLE_AUTO_REPORT
+  // Starts or stops the watchdog timer interrupt timing automatic status reports, as set by $14.
+  void system_auto_report_init();
+#endif
+
 // Returns bitfield of control pin states, organized by CONTROL_PIN_INDEX. (1=triggered, 0=not triggered).
 uint8_t system_control_get_state();
 
@@ -0,0 +1,33 @@
+/*
+  interrupt.h - interrupt shim for the host-native Grbl simulator
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef sim_avr_interrupt_h
+#define sim_avr_interrupt_h
+
+#include "avr/io.h"
+
+// Interrupt service routines compile to ordinary functions named after their vector. The
+// simulator calls them when their virtual timer or USART event comes due.
+#define ISR(vector, ...) void vector(void)
+
+// The simulator is single-threaded and only dispatches interrupts between main program
+// polls, so enabling and disabling interrupts is just the SREG global interrupt flag.
+#define sei() (SREG |= (1<<SREG_I))
+#define cli() (SREG &= ~(1<<SREG_I))
+
+#endif
@@ -0,0 +1,123 @@
+/*
+  io.h - ATmega328p register shim for the host-native Grbl simulator
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Stands in for avr-libc's <avr/io.h> when Grbl is compiled for the host. Every register that
+// cpu_map.h and the Grbl sources touch is declared here as a plain memory variable, which the
+// simulator in simulator.c inspects to drive the virtual timers, USART, and EEPROM. Only the
+// registers and bit names used by the ATmega328p cpu map are provided.
+
+#ifndef sim_avr_io_h
+#define sim_avr_io_h
+
+#include <stdint.h>
+#include "simulator.h"
+
+// Status register. Bit 7 is the global interrupt enable flag, as on the real part.
+extern volatile uint8_t SREG;
+#define SREG_I  7
+
+// General purpose I/O ports
+extern volatile uint8_t PORTB, DDRB, PINB;
+extern volatile uint8_t PORTC, DDRC, PINC;
+extern volatile uint8_t PORTD, DDRD, PIND;
+
+// Pin change interrupts
+extern volatile uint8_t PCICR, PCMSK0, PCMSK1, PCMSK2;
+#define PCIE0   0
+#define PCIE1   1
+#define PCIE2   2
+
+// Timer0. 8-bit. Step pulse reset timer.
+extern volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0;
+#define CS00    0
+#define CS01    1
+#define CS02    2
+#define WGM00   0
+#define WGM01   1
+#define WGM02   3
+#define COM0B0  4
+#define COM0B1  5
+#define COM0A0  6
+#define COM0A1  7
+#define TOIE0   0
+#define OCIE0A  1
+#define OCIE0B  2
+
+// Timer1. 16-bit. Main stepper driver timer.
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+extern volatile uint16_t TCNT1, OCR1A, OCR1B;
+#define CS10    0
+#define CS11    1
+#define CS12    2
+#define WGM10   0
+#define WGM11   1
+#define WGM12   3
+#define WGM13   4
+#define COM1B0  4
+#define COM1B1  5
+#define COM1A0  6
+#define COM1A1  7
+#define TOIE1   0
+#define OCIE1A  1
+#define OCIE1B  2
+
+// Timer2. 8-bit. Spindle PWM.
+extern volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2, TIFR2;
+#define CS20    0
+#define CS21    1
+#define CS22    2
+#define WGM20   0
+#define WGM21   1
+#define WGM22   3
+#define COM2B0  4
+#define COM2B1  5
+#define COM2A0  6
+#define COM2A1  7
+#define TOIE2   0
+#define TOV2    0
+
+// USART0
+extern volatile uint8_t UCSR0A, UCSR0B, UCSR0C, UBRR0H, UBRR0L, UDR0;
+#define U2X0    1
+#define UDRE0   5
+#define RXC0    7
+#define TXEN0   3
+#define RXEN0   4
+#define UDRIE0  5
+#define TXCIE0  6
+#define RXCIE0  7
+
+// Watchdog and reset status
+extern volatile uint8_t MCUSR, WDTCSR;
+#define WDRF    3
+#define WDP0    0
+#define WDE     3
+#define WDCE    4
+#define WDIE    6
+
+// EEPROM. The control and data registers are routed through the simulator, so that a write
+// strobe or read strobe takes effect on the backing EEPROM image exactly like the hardware.
+extern volatile uint16_t EEAR;
+#define EECR (*sim_eeprom_control_register())
+#define EEDR (*sim_eeprom_data_register())
+#define EERE    0
+#define EEPE    1
+#define EEMPE   2
+#define EERIE   3
+
+#endif
@@ -0,0 +1,33 @@
+G21 G90
+G1 X5 Y5 F3000
+G2 X10 Y5 I2.5 J0
+G3 X5 Y5 I-2.5 J0
+G0 X0 Y0
+G4 P0
+$110=6000
+$111=6000
+$112=3000
+$120=500
+$121=500
+$122=200
+G21 G90 G94 G17
+G1 X10 Y5 F600
+G1 X12 Y7
+G1 X12.05 Y7.02
+G1 X12.1 Y7.05
+G0 X0 Y0
+G1 X3 F300
+G2 X6 Y0 I1.5 J0 F800
+G3 X0 Y0 R3 Z-0.5
+G1 Z-1 F20
+G4 P0.2
+G0 Z0
+G1 X50 Y20 F2000
+G1 X51 Y20.2
+G1 X52 Y20.1
+G1 X60 Y10 Z3 F6000
+G1 X0.5 Y0.5 Z0 F10
+G0 X0 Y0
+G1 X-40 F5000
+G1 X40
+G0 X0
@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+"""\
+Segment generator equivalence test for the host-native simulator
+
+Runs a g-code job through two simulator builds and compares their step
+traces. Both builds must step every axis the same number of times and end
+in the same machine position. Each step of the test build must also occur
+within a time tolerance of the same step of the reference build.
+
+Both segment generators round the step period of every segment up to a whole
+CPU cycle, so their step periods may differ by up to a cycle, and the step
+times drift apart by up to one CPU cycle per step event executed since the
+start of the job. The tolerance is this drift, plus half of the reference
+step period, since the slowest steps at the end of a deceleration are the
+most sensitive to round-off, plus an optional fixed time. Used by
+'make sim_equivalence' to check the fixed-point segment generator against the
+floating point version.
+
+Usage: equivalence.py [-t seconds] reference_sim test_sim job.nc
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+N_AXIS = 3
+F_CPU = 16000000.0 # Simulated CPU clock (Hz)
+
+def run_sim(sim, job):
+    # Runs a simulator build from an erased EEPROM and returns its step trace.
+    fd, trace = tempfile.mkstemp(suffix='.txt')
+    os.close(fd)
+    try:
+        with open(job, 'rb') as f_in, open(os.devnull, 'wb') as f_null:
+            subprocess.check_call([sim, '-s', trace], stdin=f_in, stdout=f_null)
+        with open(trace) as f_trace:
+            return [line.split() for line in f_trace]
+    finally:
+        os.remove(trace)
+
+def axis_step_times(trace):
+    # Splits a step trace into the step times of each axis, the number of step events up to each
+    # step, and the final position.
+    times = [[] for idx in range(N_AXIS)]
+    events = [[] for idx in range(N_AXIS)]
+    position = [0]*N_AXIS
+    for n, line in enumerate(trace):
+        t = float(line[0])
+        for idx in range(N_AXIS):
+            p = int(line[idx+1])
+            if p != position[idx]:
+                times[idx].append(t)
+                events[idx].append(n+1)
+                position[idx] = p
+    return times, events, position
+
+parser = argparse.ArgumentParser(description='Compare the step traces of two simulator builds.')
+parser.add_argument('reference', help='reference grbl_sim build')
+parser.add_argument('test', help='grbl_sim build under test')
+parser.add_argument('job', help='g-code job to run')
+parser.add_argument('-t', '--tolerance', type=float, default=0.0,
+                    help='additional step time tolerance in seconds (default: 0)')
+args = parser.parse_args()
+
+ref_times, ref_events, ref_position = axis_step_times(run_sim(args.reference, args.job))
+test_times, test_events, test_position = axis_step_times(run_sim(args.test, args.job))
+
+failed = False
+for idx in range(N_AXIS):
+    ref, test = ref_times[idx], test_times[idx]
+    if len(ref) != len(test):
+        print('Axis %d: FAIL %d steps, expected %d' % (idx, len(test), len(ref)))
+        failed = True
+        continue
+    max_error = 0.0
+    max_excess = 0.0
+    for k in range(len(ref)):
+        error = abs(test[k]-ref[k])
+        period = ref[k]-ref[k-1] if k > 0 else ref[k]
+        drift = ref_events[idx][k]/F_CPU
+        max_error = max(max_error, error)
+        max_excess = max(max_excess, error-(args.tolerance+drift+0.5*period))
+    status = 'FAIL' if max_excess > 0.0 else 'ok'
+    print('Axis %d: %s %d steps, max step time error %.6f s' % (idx, status, len(ref), max_error))
+    if max_excess > 0.0:
+        failed = True
+
+if test_position != ref_position:
+    print('FAIL final position %s, expected %s' % (test_position, ref_position))
+    failed = True
+
+if failed:
+    sys.exit(1)
+print('Equivalent.')
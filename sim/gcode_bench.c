@@ -0,0 +1,83 @@
+/*
+  gcode_bench.c - host benchmark of the g-code parser
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Times gc_execute_line() on the host for a few kinds of streamed g-code lines, in g-code check
+// mode, so that only the parser runs and no motion is planned. Host times are not AVR times, but
+// the ratio between builds, like with and without ENABLE_GCODE_FAST_PATH, carries over roughly.
+
+#include <stdio.h>
+#include <time.h>
+#include "grbl.h"
+
+#define BENCH_LINES 1000
+#define BENCH_REPEATS 200
+
+static char bench_line[BENCH_LINES][LINE_BUFFER_SIZE];
+
+
+static double bench_time()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return(ts.tv_sec+1e-9*ts.tv_nsec);
+}
+
+
+// Runs the lines through the parser and prints the mean time per line. The format gets the line
+// index, and the X and Y values of a zig-zag raster path.
+static void bench_run(const char *name, const char *format)
+{
+  uint16_t idx, repeat;
+  for (idx=0; idx<BENCH_LINES; idx++) {
+    snprintf(bench_line[idx],LINE_BUFFER_SIZE,format,0.1*(idx%2 ? 1000-idx : idx),0.05*idx,idx%1000);
+  }
+  double start = bench_time();
+  for (repeat=0; repeat<BENCH_REPEATS; repeat++) {
+    for (idx=0; idx<BENCH_LINES; idx++) {
+      uint8_t status_code = gc_execute_line(bench_line[idx]);
+      if (status_code) {
+        fprintf(stderr,"error:%d in '%s'\n",status_code,bench_line[idx]);
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+  double elapsed = bench_time()-start;
+  printf("  %-28s %8.1f ns/line\n",name,1e9*elapsed/(BENCH_LINES*BENCH_REPEATS));
+}
+
+
+int main()
+{
+  sim_init();
+  settings_restore(SETTINGS_RESTORE_ALL);
+  gc_init();
+  sys.state = STATE_CHECK_MODE;
+
+  #ifdef ENABLE_GCODE_FAST_PATH
+    printf("gc_execute_line() with ENABLE_GCODE_FAST_PATH:\n");
+  #else
+    printf("gc_execute_line():\n");
+  #endif
+  gc_execute_line("G1F1000");
+  bench_run("X Y continuation",   "X%.3fY%.3f");
+  bench_run("X Y S continuation", "X%.3fY%.3fS%d");
+  bench_run("G1 X Y F full",      "G1X%.3fY%.3fF1000");
+  gc_execute_line("G0");
+  bench_run("X Y rapid",          "X%.3fY%.3f");
+  return(0);
+}
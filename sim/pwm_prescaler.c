@@ -0,0 +1,90 @@
+/*
+  pwm_prescaler.c - host test of the spindle PWM prescaler chosen for each $33 value
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Sets $33 through settings_store_global_setting(), as a '$33=' line would, and checks the Timer2
+// clock select bits written to TCCR2B against the prescaler expected for that frequency. The 328p
+// PWM frequencies are 62.5kHz, 7.8kHz, 1.96kHz, 980Hz, 490Hz, 245Hz, and 61Hz, for prescalers 1 to
+// 1024 in clock select 1 to 7. Between two of them, the closer one by ratio is selected, so the
+// cases include both sides of each geometric midpoint.
+
+#include <stdio.h>
+#include "grbl.h"
+
+#ifndef ENABLE_PWM_FREQUENCY_SETTING
+  #error "pwm_prescaler.c requires ENABLE_PWM_FREQUENCY_SETTING."
+#endif
+
+typedef struct {
+  float frequency; // $33 value (Hz)
+  uint8_t status; // Expected status code of the setting
+  uint8_t clock_select; // Expected TCCR2B CS22:0 bits
+} prescaler_case_t;
+
+static const prescaler_case_t prescaler_case[] = {
+  { 100000.0, STATUS_OK, 1 }, // Above the fastest frequency
+  {  62500.0, STATUS_OK, 1 },
+  {  22200.0, STATUS_OK, 1 }, // Midpoint 22097Hz
+  {  22000.0, STATUS_OK, 2 },
+  {   7812.5, STATUS_OK, 2 },
+  {   3920.0, STATUS_OK, 2 }, // Midpoint 3906Hz
+  {   3890.0, STATUS_OK, 3 },
+  {   1953.1, STATUS_OK, 3 },
+  {   1390.0, STATUS_OK, 3 }, // Midpoint 1381Hz
+  {   1370.0, STATUS_OK, 4 },
+  {   1000.0, STATUS_OK, 4 }, // Default
+  {    976.6, STATUS_OK, 4 },
+  {    695.0, STATUS_OK, 4 }, // Midpoint 691Hz
+  {    685.0, STATUS_OK, 5 },
+  {    488.3, STATUS_OK, 5 },
+  {    347.0, STATUS_OK, 5 }, // Midpoint 345Hz
+  {    343.0, STATUS_OK, 6 },
+  {    244.1, STATUS_OK, 6 },
+  {    123.0, STATUS_OK, 6 }, // Midpoint 122Hz
+  {    121.0, STATUS_OK, 7 },
+  {     61.0, STATUS_OK, 7 },
+  {      1.0, STATUS_OK, 7 }, // Below the slowest frequency
+  {      0.5, STATUS_INVALID_STATEMENT, 7 }, // Rejected. Keeps the last prescaler.
+  {      0.0, STATUS_INVALID_STATEMENT, 7 },
+};
+
+
+int main()
+{
+  uint8_t idx, failed = 0;
+
+  sim_init();
+  settings_restore(SETTINGS_RESTORE_ALL);
+  spindle_init();
+
+  for (idx=0; idx<(sizeof(prescaler_case)/sizeof(prescaler_case_t)); idx++) {
+    const prescaler_case_t *c = &prescaler_case[idx];
+    uint8_t status = settings_store_global_setting(33,c->frequency);
+    uint8_t clock_select = SPINDLE_TCCRB_REGISTER & 0x07;
+    uint8_t ok = (status == c->status) && (clock_select == c->clock_select);
+    printf("$33=%-9.1f %s status %d, clock select %d, expected status %d, clock select %d\n",
+           c->frequency,(ok ? "ok  " : "FAIL"),status,clock_select,c->status,c->clock_select);
+    if (!ok) { failed++; }
+  }
+
+  if (failed) {
+    printf("%d of %d cases failed.\n",failed,(int)(sizeof(prescaler_case)/sizeof(prescaler_case_t)));
+    return(EXIT_FAILURE);
+  }
+  printf("All prescalers as expected.\n");
+  return(0);
+}
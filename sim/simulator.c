@@ -0,0 +1,426 @@
+/*
+  simulator.c - host-native Grbl simulator
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  The simulator runs the unmodified Grbl sources on a Linux host, with the serial port attached
+  to stdin/stdout. The ATmega328p peripherals Grbl relies on are modeled against a virtual CPU
+  clock: Timer1 compare (stepper driver), Timer0 overflow (step pulse reset), the watchdog timer
+  interrupt, the USART receive and data register empty interrupts, and the EEPROM.
+
+  Virtual time only advances when the main program polls the realtime executor flags or
+  busy-waits in a delay, by SIM_POLL_CYCLES per poll. Computation between polls is free. This
+  means the simulator cannot measure firmware CPU load directly (profile the host binary for
+  that), but every step, segment, and serial byte is timed exactly as the hardware timers would
+  time it, and a run fed from a file is fully deterministic and repeatable.
+
+  The host is modeled as a flow-controlled sender: bytes are delivered at the configured baud
+  rate only while the serial RX buffer has room, except realtime commands, which are always
+  delivered. Like a streaming host, it waits for the welcome banner after power-up and after
+  every reset before sending, since Grbl flushes its RX buffer while re-initializing. When
+  input ends, the simulator exits as soon as Grbl has gone idle and the TX buffer has drained.
+*/
+
+#include "grbl.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <poll.h>
+
+#define SIM_POLL_CYCLES_DEFAULT 160   // Virtual cost of one main program poll. (10usec @ 16MHz)
+#define SIM_EXIT_GRACE_CYCLES (F_CPU/10) // Quiet time required after input ends before exiting.
+#define SIM_EEPROM_SIZE 1024
+#define SIM_NOT_SCHEDULED UINT64_MAX
+#define SIM_WDT_CYCLES (F_CPU/1000*16) // Watchdog timeout at the WDP2:0 = 0 prescaler. (16msec)
+
+// Interrupt service routines and entry point of the firmware, renamed for the host build.
+void TIMER1_COMPA_vect(void);
+void TIMER0_OVF_vect(void);
+void USART_RX_vect(void);
+void USART_UDRE_vect(void);
+void WDT_vect(void) __attribute__((weak)); // Only compiled in by the options using the watchdog timer.
+int grbl_main(void);
+
+// Register file. See avr/io.h.
+volatile uint8_t SREG;
+volatile uint8_t PORTB, DDRB, PINB;
+volatile uint8_t PORTC, DDRC, PINC;
+volatile uint8_t PORTD, DDRD, PIND;
+volatile uint8_t PCICR, PCMSK0, PCMSK1, PCMSK2;
+volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0;
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+volatile uint16_t TCNT1, OCR1A, OCR1B;
+volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2, TIFR2;
+volatile uint8_t UCSR0A, UCSR0B, UCSR0C, UBRR0H, UBRR0L, UDR0;
+volatile uint8_t MCUSR, WDTCSR;
+volatile uint16_t EEAR;
+
+uint64_t sim_clock;
+
+static volatile uint8_t rt_exec_state; // Backing store of sys_rt_exec_state.
+static uint8_t eecr, eedr;
+static uint8_t eeprom[SIM_EEPROM_SIZE];
+
+typedef struct {
+  uint64_t timer1_next;   // Virtual time of next Timer1 compare match.
+  uint64_t timer0_next;   // Virtual time of next Timer0 overflow.
+  uint64_t wdt_next;      // Virtual time of next watchdog timeout.
+  uint64_t rx_next;       // Earliest virtual time the next serial byte can arrive.
+  uint64_t tx_next;       // Earliest virtual time the USART data register is free.
+  uint64_t quiet_since;   // Virtual time exit conditions were first met after end of input.
+  uint64_t time_limit;    // Virtual time limit. Exits when reached.
+  uint32_t poll_cycles;
+  int rx_byte;            // Look-ahead byte from stdin. -1 when none.
+  uint8_t rx_eof;
+  uint8_t rx_hold;        // Input held until the welcome banner is received.
+  uint8_t tx_line_index;  // Character index of the current output line. Used to spot the banner.
+  uint8_t in_isr;
+  uint8_t verbose;
+  int32_t last_position[N_AXIS];
+  uint32_t step_events;
+  uint32_t tx_bytes;
+  uint32_t rx_bytes;
+  FILE *step_trace;
+  const char *eeprom_file;
+} sim_t;
+static sim_t sim;
+
+
+// Timer prescaler selected by clock select bits CSn2:0. Timer0 and Timer1 share the same table.
+static uint16_t sim_timer_prescaler(uint8_t tccrb)
+{
+  switch (tccrb & 0x07) {
+    case 1: return(1);
+    case 2: return(8);
+    case 3: return(64);
+    case 4: return(256);
+    case 5: return(1024);
+  }
+  return(0); // Stopped or external clock.
+}
+
+
+// Cycles to shift out one 8N1 byte at the baud rate configured by serial_init().
+static uint32_t sim_usart_byte_cycles()
+{
+  uint16_t ubrr = ((uint16_t)UBRR0H << 8) | UBRR0L;
+  uint8_t divisor = (UCSR0A & (1<<U2X0)) ? 8 : 16;
+  return(10*(uint32_t)divisor*(ubrr+1));
+}
+
+
+static uint8_t sim_is_realtime_command(int c)
+{
+  if (c > 0x7F) { return(true); }
+  switch (c) {
+    case CMD_RESET: case CMD_STATUS_REPORT: case CMD_CYCLE_START: case CMD_FEED_HOLD: return(true);
+  }
+  return(false);
+}
+
+
+// Watches the output for the welcome banner line, which releases held input.
+static void sim_tx_monitor(uint8_t c)
+{
+  static const char banner[] = "Grbl ";
+  if (c == '\n') {
+    if (sim.tx_line_index == sizeof(banner)-1) { sim.rx_hold = false; }
+    sim.tx_line_index = 0;
+  } else if (sim.tx_line_index < sizeof(banner)-1) {
+    if (c == banner[sim.tx_line_index]) { sim.tx_line_index++; }
+    else { sim.tx_line_index = UINT8_MAX; } // Not the banner. Ignore rest of line.
+  }
+}
+
+
+// Returns true if a serial byte is ready to be received. Reads ahead one byte from stdin, but
+// never blocks when the stepper is active, so interactive sessions keep running in real time.
+static uint8_t sim_rx_ready()
+{
+  if (sim.rx_byte >= 0) { return(true); }
+  if (sim.rx_eof) { return(false); }
+  struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+  int timeout = (TIMSK1 & (1<<OCIE1A)) ? 0 : 1; // msec
+  fflush(stdout);
+  if (poll(&pfd,1,timeout) <= 0) { return(false); }
+  uint8_t c;
+  if (read(STDIN_FILENO,&c,1) == 1) { sim.rx_byte = c; return(true); }
+  sim.rx_eof = true;
+  return(false);
+}
+
+
+static void sim_step_trace()
+{
+  uint8_t idx, moved = false;
+  int32_t position[N_AXIS];
+  st_get_realtime_position(position);
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (position[idx] != sim.last_position[idx]) { moved = true; }
+  }
+  if (!moved) { return; }
+  sim.step_events++;
+  memcpy(sim.last_position,position,sizeof(position));
+  if (sim.step_trace) {
+    fprintf(sim.step_trace,"%.6f",(double)sim_clock/F_CPU);
+    for (idx=0; idx<N_AXIS; idx++) { fprintf(sim.step_trace," %d",sim.last_position[idx]); }
+    fputc('\n',sim.step_trace);
+  }
+}
+
+
+// Executes an interrupt service routine as the hardware would: with interrupts disabled until
+// it returns. Nested interrupts are not simulated; a sei() inside an ISR only sets the flag.
+static void sim_call_isr(void (*isr)(void))
+{
+  sim.in_isr = true;
+  SREG &= ~(1<<SREG_I);
+  isr();
+  SREG |= (1<<SREG_I);
+  sim.in_isr = false;
+}
+
+
+// Updates the schedule of all interrupt sources from their current register settings.
+static void sim_update_schedule()
+{
+  // Watchdog timer in interrupt mode. Timeout doubles with each WDP2:0 prescaler step.
+  if ((WDTCSR & (1<<WDIE)) && WDT_vect) {
+    if (sim.wdt_next == SIM_NOT_SCHEDULED) { sim.wdt_next = sim_clock + (SIM_WDT_CYCLES << (WDTCSR & 0x07)); }
+  } else {
+    sim.wdt_next = SIM_NOT_SCHEDULED;
+  }
+
+  // Timer1 compare match A in CTC mode. Period of OCR1A+1 timer ticks.
+  uint16_t prescaler = sim_timer_prescaler(TCCR1B);
+  if ((TIMSK1 & (1<<OCIE1A)) && prescaler) {
+    if (sim.timer1_next == SIM_NOT_SCHEDULED) { sim.timer1_next = sim_clock + (uint32_t)(OCR1A+1)*prescaler; }
+  } else {
+    sim.timer1_next = SIM_NOT_SCHEDULED;
+  }
+
+  // Timer0 overflow. Counts up from TCNT0 to 256.
+  prescaler = sim_timer_prescaler(TCCR0B);
+  if ((TIMSK0 & (1<<TOIE0)) && prescaler) {
+    if (sim.timer0_next == SIM_NOT_SCHEDULED) { sim.timer0_next = sim_clock + (uint32_t)(256-TCNT0)*prescaler; }
+  } else {
+    sim.timer0_next = SIM_NOT_SCHEDULED;
+  }
+}
+
+
+// Advances virtual time to the given cycle count, dispatching all interrupts that come due on
+// the way in priority order. Interrupt sources are checked in ATmega328p vector table order.
+static void sim_advance(uint64_t until)
+{
+  PINB = PORTB; PINC = PORTC; PIND = PORTD; // Inputs read their pull-ups. No switch is active.
+
+  while (!sim.in_isr && (SREG & (1<<SREG_I))) {
+    sim_update_schedule();
+    uint64_t next = SIM_NOT_SCHEDULED;
+    uint8_t source = 0;
+    if (sim.wdt_next < next) { next = sim.wdt_next; source = 5; }
+    if (sim.timer1_next < next) { next = sim.timer1_next; source = 1; }
+    if (sim.timer0_next < next) { next = sim.timer0_next; source = 2; }
+    if (!sim.rx_hold && (UCSR0B & (1<<RXEN0)) && (UCSR0B & (1<<RXCIE0)) && (sim.rx_next < next)) {
+      if (sim_rx_ready() && ((serial_get_rx_buffer_available() > 0) || sim_is_realtime_command(sim.rx_byte))) {
+        next = sim.rx_next; source = 3;
+      }
+    }
+    if ((UCSR0B & (1<<TXEN0)) && (UCSR0B & (1<<UDRIE0)) && (sim.tx_next < next)) { next = sim.tx_next; source = 4; }
+    if (next > until) { break; }
+
+    if (next > sim_clock) { sim_clock = next; }
+    switch (source) {
+      case 1:
+        sim_call_isr(TIMER1_COMPA_vect);
+        sim_step_trace();
+        // In CTC mode, the timer restarts at the compare match, not when a late interrupt is serviced.
+        // So the next match is a period of the new OCR1A after this one, even if polled with cli().
+        if ((TIMSK1 & (1<<OCIE1A)) && sim_timer_prescaler(TCCR1B)) {
+          sim.timer1_next = next + (uint32_t)(OCR1A+1)*sim_timer_prescaler(TCCR1B);
+          if (sim.timer1_next < sim_clock) { sim.timer1_next = sim_clock; }
+        } else {
+          sim.timer1_next = SIM_NOT_SCHEDULED;
+        }
+        // The stepper ISR restarts Timer0 with a new count on every tick.
+        if (sim_timer_prescaler(TCCR0B)) { sim.timer0_next = SIM_NOT_SCHEDULED; }
+        break;
+      case 2:
+        sim_call_isr(TIMER0_OVF_vect);
+        TCNT0 = 0;
+        sim.timer0_next = SIM_NOT_SCHEDULED;
+        break;
+      case 3:
+        UDR0 = sim.rx_byte;
+        if (sim.rx_byte == CMD_RESET) { sim.rx_hold = true; }
+        sim.rx_byte = -1;
+        sim.rx_bytes++;
+        sim_call_isr(USART_RX_vect);
+        sim.rx_next = sim_clock + sim_usart_byte_cycles();
+        break;
+      case 4:
+        sim_call_isr(USART_UDRE_vect);
+        putchar(UDR0);
+        sim_tx_monitor(UDR0);
+        sim.tx_bytes++;
+        sim.tx_next = sim_clock + sim_usart_byte_cycles();
+        break;
+      case 5:
+        sim_call_isr(WDT_vect);
+        // In interrupt mode, the watchdog keeps timing out periodically.
+        if (WDTCSR & (1<<WDIE)) { sim.wdt_next = next + (SIM_WDT_CYCLES << (WDTCSR & 0x07)); }
+        else { sim.wdt_next = SIM_NOT_SCHEDULED; }
+        break;
+    }
+  }
+  if (until > sim_clock) { sim_clock = until; }
+}
+
+
+static void sim_exit(int status)
+{
+  sim_eeprom_control_register(); // Complete any pending EEPROM write.
+  if (sim.eeprom_file) {
+    FILE *fp = fopen(sim.eeprom_file,"wb");
+    if (fp) { fwrite(eeprom,1,SIM_EEPROM_SIZE,fp); fclose(fp); }
+  }
+  fflush(stdout);
+  if (sim.step_trace) { fclose(sim.step_trace); }
+  if (sim.verbose) {
+    fprintf(stderr,"sim: %.6f s virtual time, %u step events, %u bytes received, %u bytes sent\n",
+            (double)sim_clock/F_CPU,sim.step_events,sim.rx_bytes,sim.tx_bytes);
+  }
+  exit(status);
+}
+
+
+// Exits once input has ended and Grbl has nothing left to do: no pending realtime events,
+// idle or locked out, empty planner and serial buffers, and the last byte shifted out.
+static void sim_check_exit()
+{
+  if (sim_clock >= sim.time_limit) { sim_exit(EXIT_FAILURE); }
+  if (sim.rx_eof && (sim.rx_byte < 0) && !rt_exec_state && !sys_rt_exec_alarm &&
+      ((sys.state == STATE_IDLE) || (sys.state & (STATE_ALARM|STATE_CHECK_MODE|STATE_SLEEP))) &&
+      (plan_get_current_block() == NULL) && !(TIMSK1 & (1<<OCIE1A)) &&
+      (serial_get_rx_buffer_count() == 0) && !(UCSR0B & (1<<UDRIE0)) && (sim.tx_next <= sim_clock)) {
+    if (sim.quiet_since == SIM_NOT_SCHEDULED) { sim.quiet_since = sim_clock; }
+    else if (sim_clock-sim.quiet_since >= SIM_EXIT_GRACE_CYCLES) { sim_exit(EXIT_SUCCESS); }
+  } else {
+    sim.quiet_since = SIM_NOT_SCHEDULED;
+  }
+}
+
+
+volatile uint8_t *sim_rt_exec_state()
+{
+  if (!sim.in_isr) {
+    sim_advance(sim_clock+sim.poll_cycles);
+    sim_check_exit();
+  }
+  return(&rt_exec_state);
+}
+
+
+void sim_delay_us(double us)
+{
+  sim_advance(sim_clock+(uint64_t)(us*(F_CPU/1000000)));
+}
+
+
+// A write strobe (EEPE) completes on the next access to the control register, in the mode set
+// by the programming mode bits, mirroring the erase/write behavior relied on by eeprom.c.
+volatile uint8_t *sim_eeprom_control_register()
+{
+  if (eecr & (1<<EEPE)) {
+    uint16_t addr = EEAR % SIM_EEPROM_SIZE;
+    switch ((eecr >> 4) & 0x03) { // EEPM1:0
+      case 0: eeprom[addr] = eedr; break;  // Erase and write
+      case 1: eeprom[addr] = 0xff; break;  // Erase only
+      case 2: eeprom[addr] &= eedr; break; // Write only
+    }
+    eecr &= ~((1<<EEPE)|(1<<EEMPE));
+  }
+  return(&eecr);
+}
+
+
+// A read strobe (EERE) latches the addressed byte into the data register.
+volatile uint8_t *sim_eeprom_data_register()
+{
+  if (eecr & (1<<EERE)) {
+    eedr = eeprom[EEAR % SIM_EEPROM_SIZE];
+    eecr &= ~(1<<EERE);
+  }
+  return(&eedr);
+}
+
+
+static void sim_usage(const char *name)
+{
+  fprintf(stderr,"Usage: %s [-e eeprom.bin] [-s steps.txt] [-p poll_cycles] [-t seconds] [-v]\n"
+                 "  -e  EEPROM image file. Loaded at start and saved on exit.\n"
+                 "  -s  Write a step trace: virtual time and machine position in steps per step event.\n"
+                 "  -p  Virtual CPU cycles consumed by each main program poll. Default %u.\n"
+                 "  -t  Virtual time limit in seconds. Exits with failure when reached.\n"
+                 "  -v  Print a run summary to stderr on exit.\n",
+          name,SIM_POLL_CYCLES_DEFAULT);
+  exit(EXIT_FAILURE);
+}
+
+
+void sim_init()
+{
+  memset(&sim,0,sizeof(sim));
+  sim.poll_cycles = SIM_POLL_CYCLES_DEFAULT;
+  sim.time_limit = SIM_NOT_SCHEDULED;
+  sim.quiet_since = SIM_NOT_SCHEDULED;
+  sim.timer0_next = sim.timer1_next = sim.wdt_next = SIM_NOT_SCHEDULED;
+  sim.rx_byte = -1;
+  sim.rx_hold = true;
+  memset(eeprom,0xff,SIM_EEPROM_SIZE); // Erased EEPROM state.
+}
+
+
+int main(int argc, char *argv[])
+{
+  int opt;
+  sim_init();
+  while ((opt = getopt(argc,argv,"e:s:p:t:v")) != -1) {
+    switch (opt) {
+      case 'e': {
+        sim.eeprom_file = optarg;
+        FILE *fp = fopen(optarg,"rb");
+        if (fp) {
+          if (fread(eeprom,1,SIM_EEPROM_SIZE,fp) != SIM_EEPROM_SIZE) { memset(eeprom,0xff,SIM_EEPROM_SIZE); }
+          fclose(fp);
+        }
+        break;
+      }
+      case 's':
+        if (!(sim.step_trace = fopen(optarg,"w"))) { perror(optarg); exit(EXIT_FAILURE); }
+        break;
+      case 'p': sim.poll_cycles = strtoul(optarg,NULL,0); break;
+      case 't': sim.time_limit = (uint64_t)(strtod(optarg,NULL)*F_CPU); break;
+      case 'v': sim.verbose = true; break;
+      default: sim_usage(argv[0]);
+    }
+  }
+  if (sim.poll_cycles == 0) { sim_usage(argv[0]); }
+
+  grbl_main();
+  return(0); // Never reached
+}
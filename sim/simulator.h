@@ -0,0 +1,45 @@
+/*
+  simulator.h - host-native Grbl simulator hardware hooks
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef simulator_h
+#define simulator_h
+
+#include <stdint.h>
+
+// Virtual CPU clock in F_CPU cycles since power-up. Only advances when the main program polls
+// or busy-waits, which makes a simulation run fully deterministic for a given input.
+extern uint64_t sim_clock;
+
+// Every busy-wait loop in Grbl polls the realtime executor flags. Routing those accesses through
+// the simulator gives it a hook to advance virtual time and dispatch any interrupts that came due,
+// without altering the firmware sources. Only the Grbl sources see this through avr/io.h.
+volatile uint8_t *sim_rt_exec_state();
+#define sys_rt_exec_state (*sim_rt_exec_state())
+
+// Resets the simulator to power-up, with an erased EEPROM. Called by the simulator's main(), and
+// by other host programs that link the hardware shim, like the g-code parser benchmark.
+void sim_init();
+
+// Busy-wait delay. Advances virtual time by the requested microseconds.
+void sim_delay_us(double us);
+
+// EEPROM control and data registers. Accesses apply any pending read or write strobe.
+volatile uint8_t *sim_eeprom_control_register();
+volatile uint8_t *sim_eeprom_data_register();
+
+#endif